@@ -35,6 +35,9 @@
 #include <fstream>
 #include <iomanip>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <vector>
 
 
@@ -46,6 +49,14 @@ namespace
 		std::filesystem::path theBoxPGPath{};
 		std::filesystem::path theIndPGPath{};
 		std::filesystem::path theOutPath{};
+		std::size_t theNumThreads{ 1u };
+		std::size_t theNumFitThreads{ 0u }; // zero for those beyond trials
+		std::size_t theNumAngCands{ 0u }; // zero for brute force search
+		bool theIsPruned{ false }; // abandon hopeless conventions early
+		double theMaxPairError{ 0. }; // zero to score all conventions
+		std::string theCachePath{}; // empty for no Box table cache
+		bool theIsProfile{ false }; // report stage timing and counters
+		std::string theProfilePath{}; // empty for no JSON profile output
 
 		//! True if verboase output has been requested
 		inline
@@ -56,6 +67,58 @@ namespace
 			return true; // TODO could control with command line option
 		}
 
+		//! Positive count from argument after argv[narg] (narg is advanced)
+		inline
+		static
+		bool
+		countFrom
+			( int const argc
+			, char * argv[]
+			, int & narg
+			, std::size_t & count
+			)
+		{
+			bool okay{ false };
+			if ((narg + 1) < argc)
+			{
+				std::istringstream iss(argv[++narg]);
+				std::size_t value{ 0u };
+				iss >> value;
+				if ((! iss.fail()) && (0u < value))
+				{
+					count = value;
+					okay = true;
+				}
+			}
+			return okay;
+		}
+
+		//! Positive value from argument after argv[narg] (narg is advanced)
+		inline
+		static
+		bool
+		valueFrom
+			( int const argc
+			, char * argv[]
+			, int & narg
+			, double & value
+			)
+		{
+			bool okay{ false };
+			if ((narg + 1) < argc)
+			{
+				std::istringstream iss(argv[++narg]);
+				double tmp{ 0. };
+				iss >> tmp;
+				if ((! iss.fail()) && (0. < tmp))
+				{
+					value = tmp;
+					okay = true;
+				}
+			}
+			return okay;
+		}
+
 		//! Check invocation arguments.
 		explicit
 		Usage
@@ -63,23 +126,145 @@ namespace
 			, char * argv[]
 			)
 		{
-			int narg{ 1 };
-			if (! (4 == argc))
+			// separate options from positional arguments
+			std::vector<std::string> args;
+			bool okay{ true };
+			for (int narg{1} ; narg < argc ; ++narg)
+			{
+				std::string const arg(argv[narg]);
+				if ("--threads" == arg)
+				{
+					okay = okay && countFrom(argc, argv, narg, theNumThreads);
+				}
+				else
+				if ("--fit-threads" == arg)
+				{
+					okay = okay
+						&& countFrom(argc, argv, narg, theNumFitThreads);
+				}
+				else
+				if ("--rotation-first" == arg)
+				{
+					okay = okay && countFrom(argc, argv, narg, theNumAngCands);
+				}
+				else
+				if ("--prune" == arg)
+				{
+					theIsPruned = true;
+				}
+				else
+				if ("--near" == arg)
+				{
+					okay = okay && valueFrom(argc, argv, narg, theMaxPairError);
+				}
+				else
+				if ("--cache" == arg)
+				{
+					okay = okay && ((narg + 1) < argc);
+					if (okay)
+					{
+						theCachePath = argv[++narg];
+					}
+				}
+				else
+				if ("--profile" == arg)
+				{
+					theIsProfile = true;
+				}
+				else
+				if ("--profile-json" == arg)
+				{
+					okay = okay && ((narg + 1) < argc);
+					if (okay)
+					{
+						theProfilePath = argv[++narg];
+					}
+				}
+				else
+				{
+					args.emplace_back(arg);
+				}
+			}
+
+			if (! (okay && (3u == args.size())))
 			{
 				std::cerr << '\n' << argv[0] << " Bad invocation:"
 					"\nUsage:"
 					"\n  <ProgName> <BoxPGPath> <IndPGPath> <OutPath>"
+						" [--threads N] [--fit-threads M]"
+					"\n    [--rotation-first K] [--prune] [--near E]"
+						" [--cache CachePath] [--profile]"
+					"\n    [--profile-json JsonPath]"
+					"\n"
+					"\n  --threads N : Number of threads to use (default: 1)"
+					"\n  --fit-threads M : Threads (of the N) used within"
+						" each trial's fit"
+					"\n      evaluation, N/M trials run concurrently"
+						" (default: those beyond"
+					"\n      one thread per trial, i.e. 1 unless there"
+						" are fewer trials than N)"
+					"\n  --rotation-first K : Two-stage search that fully"
+						" evaluates only"
+					"\n      the K angle conventions with best rotation fit"
+						" (default: all)"
+					"\n  --prune : Branch-and-bound search (same best fits,"
+						" but EndFit>="
+					"\n      and promFrac<= are bounds, and results are"
+						" ranked by 2ndFit-fitError)"
+					"\n  --near E : Report only trials with fits having every"
+						" RO error"
+					"\n      within E (found via spatial index, EndFit>= and"
+						" promFrac<="
+					"\n      are then bounds from these near fits only)"
+					"\n  --cache CachePath : File with Box ROs from previous"
+						" run with same"
+					"\n      Box data (it is (re)generated if missing or"
+						" out of date)"
+					"\n  --profile : Report time spent in each processing"
+						" stage and counts"
+					"\n      of transforms, inverses and conventions"
+						" evaluated (to stdout)"
+					"\n  --profile-json JsonPath : Write the profile"
+						" values to a JSON file"
 					"\n\n"
 					;
 			}
 			else
 			{
-				theBoxPGPath = argv[narg++];
-				theIndPGPath = argv[narg++];
-				theOutPath = argv[narg++];
+				std::size_t narg{ 0u };
+				theBoxPGPath = args[narg++];
+				theIndPGPath = args[narg++];
+				theOutPath = args[narg++];
 			}
 		}
 
+		//! True if two-stage (rotation first) search is requested
+		inline
+		bool
+		isRotationFirst
+			() const
+		{
+			return (0u < theNumAngCands);
+		}
+
+		//! True if (spatial index) search for near fits is requested
+		inline
+		bool
+		isNear
+			() const
+		{
+			return (0. < theMaxPairError);
+		}
+
+		//! True if stage timing and counters are to be reported
+		inline
+		bool
+		isProfile
+			() const
+		{
+			return (theIsProfile || (! theProfilePath.empty()));
+		}
+
 		//! True if input file path is set to existing file.
 		inline
 		bool
@@ -195,28 +380,93 @@ main
 
 	using namespace om;
 
-	// load interior Box ParmGroups from specified file
-	std::ifstream ifsBoxPG(use.theBoxPGPath);
-	std::map<om::SenKey, om::ParmGroup>
-		const keyBoxPGs{ om::loadParmGroups(ifsBoxPG) };
+	// stage times and counters accumulate from here (if enabled)
+	om::prof::reset();
+
+	std::map<om::SenKey, om::ParmGroup> keyBoxPGs;
+	std::map<om::SenKey, om::ParmGroup> keyIndPGs;
+	om::SenRegistry registry;
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::Load);
+
+		// load interior Box ParmGroups from specified file
+		keyBoxPGs = om::loadParmGroupsFile(use.theBoxPGPath);
+
+		// load exterior Ind parameter group from specified file
+		keyIndPGs = om::loadParmGroupsFile(use.theIndPGPath);
+
+		// intern sensor keys (from both files) as dense index values
+		registry = om::SenRegistry::fromKeysOf(keyBoxPGs, keyIndPGs);
+	}
 
 	// try all internal conventions
-	std::vector<om::Convention> const allBoxCons
-		{ Convention::allConventions() };
+	std::vector<om::Convention> allBoxCons;
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::Conventions);
+		allBoxCons = Convention::allConventions();
+	}
 
+	// Box ROs are the same for every Ind trial - compute them only once
+	// (unless using two-stage search which evaluates only a few of them)
+	om::BoxRelOriTable boxTable{};
+	std::map<om::SenKey, om::AttitudeTable> keyBoxTables;
+	if (use.isRotationFirst())
+	{
+		// Box attitudes (for all angle conventions) shared by all trials
+		om::prof::StageTimer const timer(om::prof::Stage::RelOris);
+		keyBoxTables = om::attitudeTablesFor(keyBoxPGs);
+	}
+	else
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::RelOris);
+		if (use.theCachePath.empty())
+		{
+			boxTable = om::BoxRelOriTable::from
+				( registry
+				, om::attitudeTablesFor(registry, keyBoxPGs)
+				, allBoxCons
+				);
+		}
+		else
+		{
+			// reuse (or save for reuse) the Box ROs from a file
+			bool fromCache{ false };
+			boxTable = om::cachedBoxTable
+				( use.theCachePath, registry, keyBoxPGs, allBoxCons
+				, &fromCache
+				);
+			if (use.isVerbose())
+			{
+				std::cout << "# Box table cache: " << use.theCachePath
+					<< (fromCache ? " (loaded)" : " (generated)") << '\n';
+			}
+		}
+	}
 
-	// load exterior Ind parameter group from specified file
-	std::ifstream ifsIndPG(use.theIndPGPath);
-	std::map<om::SenKey, om::ParmGroup>
-		const keyIndPGs{ om::loadParmGroups(ifsIndPG) };
+	// spatial index of Box ROs (for finding those near to Ind ROs)
+	om::BoxRelOriIndex boxIndex{};
+	if (use.isNear() && (! use.isRotationFirst()))
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::RelOris);
+		boxIndex = om::BoxRelOriIndex::from(boxTable);
+	}
+
+	// attitudes for all Ind angle conventions (shared by offset/order)
+	std::map<om::SenKey, om::AttitudeTable> keyIndTables;
+	std::vector<om::AttitudeTable> indTables;
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::IndEOs);
+		keyIndTables = om::attitudeTablesFor(keyIndPGs);
+		indTables = om::attitudeTablesFor(registry, keyIndPGs);
+	}
 
 	//! Conventions for Ind EO interpretations
 	om::ConventionOffset const indConvOffset{ { 1, 1, 1 }, { 0u, 1u, 2u } };
-	std::vector<om::Convention> const allIndCons
-		{ Convention::allConventionsFor(indConvOffset) };
-
-	std::vector<om::OneTrialResult> trialResults;
-	std::vector<om::OneSolutionFit> solns;
+	std::vector<om::Convention> allIndCons;
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::Conventions);
+		allIndCons = Convention::allConventionsFor(indConvOffset);
+	}
 
 	if (use.isVerbose())
 	{
@@ -225,76 +475,212 @@ main
 		std::cout << "# keyIndPGs count: " << keyIndPGs.size() << '\n';
 		std::cout << "# allIndCons.size() : " << allIndCons.size() << "\n";
 		std::cout << "# indEO count: " << allIndCons.size() << '\n';
+		std::cout << "# thread count: " << use.theNumThreads << '\n';
 	}
-	for (om::Convention const & currIndCon : allIndCons)
+
+	// Ind trials are independent - run them concurrently. Threads are
+	// divided between trials and each trial's fit evaluation such that
+	// (numTrialThreads * numFitThreads) is at most theNumThreads.
+	std::size_t const numTrials{ allIndCons.size() };
+	std::size_t numFitThreads{ use.theNumFitThreads };
+	if (0u == numFitThreads)
 	{
-		//! Get independent station grouping for current Ind convention
-		std::map<SenKey, SenOri> const indKeyStas
-			{ om::keyOrisFor(keyIndPGs, currIndCon) };
+		// by default, threads beyond one per trial
+		std::size_t const numBusy
+			{ std::max
+				(std::size_t{ 1u }, std::min(use.theNumThreads, numTrials))
+			};
+		numFitThreads = use.theNumThreads / numBusy;
+	}
+	numFitThreads = std::max
+		(std::size_t{ 1u }, std::min(numFitThreads, use.theNumThreads));
+	std::size_t const numTrialThreads
+		{ std::max
+			( std::size_t{ 1u }
+			, std::min(numTrials, use.theNumThreads / numFitThreads)
+			)
+		};
+	if (use.isVerbose())
+	{
+		std::cout << "# trial threads: " << numTrialThreads << '\n';
+		std::cout << "# fit threads per trial: " << numFitThreads << '\n';
+	}
 
-		std::vector<om::FitNdxPair> fitIndexPairs
-			{ fitIndexPairsFor(keyBoxPGs, indKeyStas, allBoxCons) };
+	// one result slot per trial (so that order matches allIndCons)
+	std::vector<om::OneTrialResult> trialSlots(numTrials);
+	// which slots hold a result (char, not bool, for concurrent writes)
+	std::vector<char> hasSlotResults(numTrials, 0);
 
-		// report data encountered - for debugging
-		constexpr bool showIntermediateData{ false };
-		if (showIntermediateData)
-		{
-			std::cout << rpt::stringInputs(keyBoxPGs, indKeyStas);
-			std::cout << rpt::stringSolution(fitIndexPairs, allBoxCons);
-		}
+	// serialize console output from concurrent trials
+	std::mutex coutMutex;
 
-		// find the best solution for this trial
-		if (! fitIndexPairs.empty())
+	// perform one trial with the Ind convention allIndCons[trialNdx]
+	auto const runTrial
+		{ [&]
+			( std::size_t const trialNdx
+			)
 		{
-			om::OneTrialResult const trialResult
-				{ om::trialResultFrom(fitIndexPairs, allBoxCons, currIndCon) };
-			trialResults.emplace_back(trialResult);
+			om::Convention const & currIndCon = allIndCons[trialNdx];
 
-			if (use.isVerbose())
+			// time not attributed to (nested) stages is spent fitting
+			om::prof::StageTimer const timer(om::prof::Stage::Fit);
+
+			om::FitNdxSelector fitSelection;
+			bool isSkipped{ false }; // e.g. no fits near enough
+			if (use.isRotationFirst())
 			{
-				using engabra::g3::io::fixed;
-				std::cout << std::setw(4u) << trialResults.size()
-					<< ' ' << trialResult.infoString() << '\n';
-				std::cout << std::flush; // for watching progress if piped
+				//! Get independent station grouping for current Ind convention
+				std::map<SenKey, SenOri> const indKeyStas
+					{ om::keyOrisFor(keyIndTables, currIndCon) };
+
+				// indices refer to allBoxCons (== allConventions())
+				// (worst is only that of the evaluated candidates)
+				fitSelection = om::fitSelectionRotationFirst
+					(keyBoxTables, indKeyStas, use.theNumAngCands);
+			}
+			else
+			if (use.isNear())
+			{
+				// score only conventions near to all Ind ROs
+				om::NearSelection const nearSel
+					{ fitSelectionNearFor
+						( boxTable, boxIndex, indTables, currIndCon
+						, use.theMaxPairError
+						)
+					};
+				isSkipped = (0u == nearSel.theSelector.theNumSeen);
+				if (nearSel.isExact())
+				{
+					fitSelection = nearSel.theSelector;
+				}
+				else
+				if (! isSkipped)
+				{
+					// near fits found, but better ones might exist
+					fitSelection = fitSelectionFor
+						(boxTable, indTables, currIndCon, 2u, numFitThreads);
+				}
+			}
+			else
+			if (use.theIsPruned)
+			{
+				// as below, but abandon hopeless conventions early
+				fitSelection = fitSelectionPrunedFor
+					(boxTable, indTables, currIndCon, 2u, numFitThreads);
+			}
+			else
+			{
+				// Ind stations (in registry order) for current Ind convention
+				// (best and worst selected without collecting all fits)
+				fitSelection = fitSelectionFor
+					(boxTable, indTables, currIndCon, 2u, numFitThreads);
+			}
+
+			// report data encountered - for debugging
+			constexpr bool showIntermediateData{ false };
+			if (showIntermediateData)
+			{
+				std::map<SenKey, SenOri> const indKeyStas
+					{ om::keyOrisFor(keyIndTables, currIndCon) };
+				std::vector<om::FitNdxPair> const fitIndexPairs
+					{ fitIndexPairsFor(keyBoxPGs, indKeyStas, allBoxCons) };
+				std::lock_guard<std::mutex> const lock(coutMutex);
+				std::cout << rpt::stringInputs(keyBoxPGs, indKeyStas);
+				std::cout << rpt::stringSolution(fitIndexPairs, allBoxCons);
+			}
+
+			om::prof::count
+				(om::prof::Counter::Conventions, fitSelection.theNumSeen);
+
+			// find the best solution for this trial
+			if (0u < fitSelection.theNumSeen)
+			{
+				om::OneTrialResult trialResult;
+				{
+					om::prof::StageTimer const timer(om::prof::Stage::Select);
+					trialResult = om::trialResultFrom
+						(fitSelection, allBoxCons, currIndCon);
+				}
+				trialSlots[trialNdx] = trialResult;
+				hasSlotResults[trialNdx] = 1;
+
+				if (use.isVerbose())
+				{
+					om::prof::StageTimer const timer(om::prof::Stage::Report);
+					// format complete line before (briefly) locking output
+					std::ostringstream msg;
+					msg << std::setw(4u) << (trialNdx + 1u)
+						<< ' ' << trialResult.infoString() << '\n';
+					std::lock_guard<std::mutex> const lock(coutMutex);
+					std::cout << msg.str();
+					std::cout << std::flush; // for watching progress if piped
+				}
+			}
+			else
+			if (! isSkipped)
+			{
+				std::lock_guard<std::mutex> const lock(coutMutex);
+				std::cerr << "Error: No results to report\n" << std::endl;
 			}
 		}
-		else
-		{
-			std::cerr << "Error: No results to report\n" << std::endl;
-		}
+		};
 
-		// for dev/testing
-		/*
-		if (5 < trialResults.size())
+	om::par::forEachIndex(numTrials, numTrialThreads, runTrial);
+
+	// gather results (in allIndCons order) from every trial that had fits
+	// (including non-finite ones) - skipped trials have no result
+	std::vector<om::OneTrialResult> trialResults;
+	{
+		om::prof::StageTimer const timer(om::prof::Stage::Select);
+		trialResults.reserve(numTrials);
+		for (std::size_t nn{0u} ; nn < numTrials ; ++nn)
 		{
-			break;
+			if (0 != hasSlotResults[nn])
+			{
+				trialResults.emplace_back(trialSlots[nn]);
+			}
 		}
-		*/
+
+		// sort overall trial results for reporting
+		om::sortForReport(&trialResults);
 	}
 
 	//
 	// Report results
 	//
 
-	// sort overall trial results for reporting
-	std::sort(trialResults.begin(), trialResults.end());
-
 	// show results
-	std::ofstream ofsOut(use.theOutPath);
-	ofsOut << "#\n";
-	ofsOut << "# KeyBoxPGs count: " << keyBoxPGs.size() << '\n';
-	ofsOut << "# KeyIndPGs count: " << keyIndPGs.size() << '\n';
-	ofsOut << "# AllBoxCons count: " << allBoxCons.size() << std::endl;
-	ofsOut << "# AllIndCons.size() : " << allIndCons.size() << "\n";
-	ofsOut << "# TrialResults count: " << trialResults.size() << '\n';
-	ofsOut << "#\n";
-	for (om::OneTrialResult const & trialResult : trialResults)
 	{
-		ofsOut << trialResult << '\n';
+		om::prof::StageTimer const timer(om::prof::Stage::Report);
+		std::ofstream ofsOut(use.theOutPath);
+		ofsOut << "#\n";
+		ofsOut << "# KeyBoxPGs count: " << keyBoxPGs.size() << '\n';
+		ofsOut << "# KeyIndPGs count: " << keyIndPGs.size() << '\n';
+		ofsOut << "# AllBoxCons count: " << allBoxCons.size() << std::endl;
+		ofsOut << "# AllIndCons.size() : " << allIndCons.size() << "\n";
+		ofsOut << "# TrialResults count: " << trialResults.size() << '\n';
+		ofsOut << "#\n";
+		for (om::OneTrialResult const & trialResult : trialResults)
+		{
+			ofsOut << trialResult << '\n';
+		}
+		ofsOut << "#\n";
+	}
+
+	// stage timing and counters
+	if (use.isProfile())
+	{
+		om::prof::Snapshot const profile{ om::prof::Snapshot::current() };
+		if (use.theIsProfile)
+		{
+			std::cout << profile.infoString();
+		}
+		if (! use.theProfilePath.empty())
+		{
+			std::ofstream ofsProfile(use.theProfilePath);
+			ofsProfile << profile.json();
+		}
 	}
-	ofsOut << "#\n";
 
 	return 0;
 }
-
-
@@ -0,0 +1,370 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Timing of the main OriMania analysis stages (JSON report).
+
+Each stage is evaluated on simulated data (ref test/Simulation.hpp) for
+several sensor counts and (where the stage is multi-threaded) for
+several thread counts. Each stage is called repeatedly until at least
+minSeconds of wall time has elapsed, and the time per call is reported.
+
+Results are put to stdout as a JSON array with one object per stage
+evaluation. Each object has members "stage", "numSen", "numThreads",
+"numCalls", "secondsPerCall", "numItems" (e.g. conventions) per call,
+and "itemsPerSecond".
+
+Usage: bench_OriMania [maxThreads [minSeconds]]
+*/
+
+
+#include "OriMania.hpp"
+#include "Simulation.hpp"
+
+#include <Engabra>
+#include <Rigibra>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	//! Wall time per call from repeated evaluations.
+	struct Timing
+	{
+		std::size_t theNumCalls{ 0u };
+		double theSecPerCall{ 0. };
+
+		//! Timing of func() calls repeated for at least minSeconds.
+		template <typename Func>
+		inline
+		static
+		Timing
+		of
+			( Func const & func
+			, double const & minSeconds
+			)
+		{
+			using Clock = std::chrono::steady_clock;
+			Clock::time_point const t0{ Clock::now() };
+			double elapsed{ 0. };
+			std::size_t numCalls{ 0u };
+			while ((0u == numCalls) || (elapsed < minSeconds))
+			{
+				func();
+				++numCalls;
+				elapsed = std::chrono::duration<double>
+					(Clock::now() - t0).count();
+			}
+			return Timing
+				{ numCalls, elapsed / static_cast<double>(numCalls) };
+		}
+
+	}; // Timing
+
+	//! Accumulation of JSON report records.
+	struct Report
+	{
+		double theMinSeconds{ .25 };
+		std::vector<std::string> theRecords{};
+
+		//! Time func() and record result for stage.
+		template <typename Func>
+		inline
+		void
+		add
+			( std::string const & stage
+			, std::size_t const & numSen
+			, std::size_t const & numThreads
+			, std::size_t const & numItems
+			, Func const & func
+			)
+		{
+			Timing const timing{ Timing::of(func, theMinSeconds) };
+			std::ostringstream oss;
+			oss << "{ \"stage\": \"" << stage << "\""
+				<< ", \"numSen\": " << numSen
+				<< ", \"numThreads\": " << numThreads
+				<< ", \"numCalls\": " << timing.theNumCalls
+				<< ", \"secondsPerCall\": " << timing.theSecPerCall
+				<< ", \"numItems\": " << numItems
+				<< ", \"itemsPerSecond\": "
+					<< (static_cast<double>(numItems) / timing.theSecPerCall)
+				<< " }";
+			theRecords.emplace_back(oss.str());
+			std::cerr << "# " << theRecords.back() << std::endl;
+		}
+
+		//! JSON array of all records
+		inline
+		std::string
+		json
+			() const
+		{
+			std::ostringstream oss;
+			oss << "[\n";
+			for (std::size_t nn{0u} ; nn < theRecords.size() ; ++nn)
+			{
+				oss << theRecords[nn];
+				if ((nn + 1u) < theRecords.size())
+				{
+					oss << ',';
+				}
+				oss << '\n';
+			}
+			oss << "]\n";
+			return oss.str();
+		}
+
+	}; // Report
+
+	//! First numSen of the simulation key groups
+	std::map<om::SenKey, om::ParmGroup>
+	keyGroupsFor
+		( std::size_t const & numSen
+		)
+	{
+		std::map<om::SenKey, om::ParmGroup> keyGroups;
+		for (std::map<om::SenKey, om::ParmGroup>::value_type
+			const & keyGroup : om::sim::sKeyGroups)
+		{
+			if (keyGroups.size() < numSen)
+			{
+				keyGroups.emplace_hint(keyGroups.end(), keyGroup);
+			}
+		}
+		return keyGroups;
+	}
+
+	//! Thread counts 1, 2, 4, ... up to (and including) maxThreads
+	std::vector<std::size_t>
+	threadCountsFor
+		( std::size_t const & maxThreads
+		)
+	{
+		std::vector<std::size_t> counts;
+		std::size_t count{ 1u };
+		while (count < maxThreads)
+		{
+			counts.emplace_back(count);
+			count *= 2u;
+		}
+		counts.emplace_back(maxThreads);
+		return counts;
+	}
+
+	//! Value that depends on xfm (to keep computations from being elided)
+	inline
+	double
+	valueOf
+		( om::SenOri const & xfm
+		)
+	{
+		return (xfm.theLoc[0] + xfm.theAtt.spinor().theSca[0]);
+	}
+
+} // [anon]
+
+
+//! Time analysis stages for several sensor and thread counts.
+int
+main
+	( int argc
+	, char * argv[]
+	)
+{
+	std::size_t maxThreads
+		{ std::max(1u, std::thread::hardware_concurrency()) };
+	Report report;
+	if (1 < argc)
+	{
+		maxThreads = std::max
+			( std::size_t{ 1u }
+			, static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10))
+			);
+	}
+	if (2 < argc)
+	{
+		report.theMinSeconds = std::strtod(argv[2], nullptr);
+	}
+
+	using namespace om;
+	std::vector<Convention> const allCons{ Convention::allConventions() };
+	std::size_t const numCons{ allCons.size() };
+	std::vector<std::size_t> const threadCounts
+		{ threadCountsFor(maxThreads) };
+	Convention const & simCon = om::sim::sConventionA;
+
+	// (subsets of the simulation data - which has seven sensors)
+	std::vector<std::size_t> const senCounts{ 3u, 5u, 7u };
+
+	double sink{ 0. };
+	for (std::size_t const & numSen : senCounts)
+	{
+		std::map<SenKey, ParmGroup> const keyGroups{ keyGroupsFor(numSen) };
+
+		// simulated independent (Ind) data
+		std::map<SenKey, SenOri> const boxKeyOris
+			{ om::sim::boxKeyOris(keyGroups, simCon) };
+		std::map<SenKey, SenOri> const indKeyOris
+			{ om::sim::independentKeyOris(boxKeyOris) };
+		std::map<KeyPair, SenOri> const relKeyOris
+			{ relativeOrientationBetweens(indKeyOris) };
+		std::size_t const numPairs{ relKeyOris.size() };
+
+		// per sensor, per convention transformations
+		report.add
+			( "Convention::transformFor", numSen, 1u, numSen * numCons
+			, [&] ()
+				{
+					for (Convention const & convention : allCons)
+					{
+						for (std::map<SenKey, ParmGroup>::value_type
+							const & keyGroup : keyGroups)
+						{
+							sink += valueOf
+								(convention.transformFor(keyGroup.second));
+						}
+					}
+				}
+			);
+		report.add
+			( "Convention::attitudeFor", numSen, 1u, numSen * numCons
+			, [&] ()
+				{
+					for (Convention const & convention : allCons)
+					{
+						for (std::map<SenKey, ParmGroup>::value_type
+							const & keyGroup : keyGroups)
+						{
+							sink += convention.attitudeFor(keyGroup.second)
+								.spinor().theSca[0];
+						}
+					}
+				}
+			);
+		report.add
+			( "AttitudeTable::from", numSen, 1u
+			, numSen * ConventionAngle::theNumConventions
+			, [&] ()
+				{
+					for (std::map<SenKey, ParmGroup>::value_type
+						const & keyGroup : keyGroups)
+					{
+						sink += AttitudeTable::from(keyGroup.second)
+							.theAtts.size();
+					}
+				}
+			);
+
+		// relative orientations among Ind EOs
+		report.add
+			( "relativeOrientationBetweens", numSen, 1u, numPairs
+			, [&] ()
+				{
+					sink += relativeOrientationBetweens(indKeyOris).size();
+				}
+			);
+
+		// Box RO table (once per Box data set)
+		report.add
+			( "BoxRelOriTable::from", numSen, 1u, numCons
+			, [&] ()
+				{
+					sink += BoxRelOriTable::from(keyGroups, allCons)
+						.theClasses.numClasses();
+				}
+			);
+
+		// fit errors for all conventions (per Ind trial)
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from(keyGroups, allCons) };
+		for (std::size_t const & numThreads : threadCounts)
+		{
+			report.add
+				( "fitErrorByConvention(BoxRelOriTable)"
+				, numSen, numThreads, numCons
+				, [&] ()
+					{
+						sink += fitErrorByConvention
+							(boxTable, relKeyOris, numThreads).front();
+					}
+				);
+			report.add
+				( "fitErrorByConvention(ParmGroups)"
+				, numSen, numThreads, numCons
+				, [&] ()
+					{
+						sink += fitErrorByConvention
+							(keyGroups, relKeyOris, allCons, numThreads)
+							.front();
+					}
+				);
+		}
+
+		// best/worst selection and result formation (per Ind trial)
+		std::vector<FitNdxPair> const fitIndexPairs
+			{ fitIndexPairsFor(keyGroups, relKeyOris, allCons) };
+		report.add
+			( "trialResultFrom", numSen, 1u, numCons
+			, [&] ()
+				{
+					sink += trialResultFrom(fitIndexPairs, allCons, simCon)
+						.the1st.theFitError;
+				}
+			);
+
+		// data loaders (per sensor)
+		std::string const pgText{ om::sim::parmGroupText(keyGroups) };
+		std::string const eoText{ om::sim::indEOText(keyGroups, simCon) };
+		report.add
+			( "loadParmGroups", numSen, 1u, numSen
+			, [&] ()
+				{
+					sink += loadParmGroups(pgText).size();
+				}
+			);
+		report.add
+			( "loadIndEOs", numSen, 1u, numSen
+			, [&] ()
+				{
+					sink += loadIndEOs(eoText).size();
+				}
+			);
+	}
+
+	std::cout << report.json();
+	std::cerr << "# sink: " << sink << '\n';
+	return 0;
+}
+
@@ -0,0 +1,227 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Throughput of ParmGroup and Ind EO text file loaders.
+
+Writes synthetic data files (with numSen sensors) in the formats of
+data/exampParmGroup.txt and of the Ind EO example in test_io.cpp. Then
+times the (stream and memory mapped file) loaders for each. Results are
+put to stdout as JSON.
+
+Usage: bench_io [numSen [numRep]]
+*/
+
+
+#include "io.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+	//! Synthetic (ParmGroup or Ind EO) file content for numSen sensors
+	std::string
+	textFor
+		( std::size_t const & numSen
+		, bool const & withConvention
+		)
+	{
+		std::mt19937 gen(47u);
+		std::uniform_real_distribution<double> distDist(-100., 100.);
+		std::uniform_real_distribution<double> angleDist(-3., 3.);
+		std::ostringstream oss;
+		oss << std::fixed << std::setprecision(6);
+		oss << "# synthetic data for bench_io\n";
+		for (std::size_t nn{0u} ; nn < numSen ; ++nn)
+		{
+			std::string const key{ "sen" + std::to_string(nn) };
+			oss << '\n';
+			if (withConvention)
+			{
+				oss << "Convention: " << key << "  -+- 021 +-- 102 210 0\n";
+			}
+			oss << (withConvention ? "Locations:  " : "Distances:  ") << key
+				<< "  " << distDist(gen)
+				<< "  " << distDist(gen)
+				<< "  " << distDist(gen)
+				<< "  # [m]\n";
+			oss << "Angles:     " << key
+				<< "  " << angleDist(gen)
+				<< "  " << angleDist(gen)
+				<< "  " << angleDist(gen)
+				<< "\n";
+		}
+		return oss.str();
+	}
+
+	//! Minimum (over numRep runs) wall time [sec] for func() to complete
+	template <typename Func>
+	double
+	minSecondsFor
+		( Func const & func
+		, std::size_t const & numRep
+		)
+	{
+		double minSec{ std::numeric_limits<double>::max() };
+		for (std::size_t nRep{0u} ; nRep < numRep ; ++nRep)
+		{
+			std::chrono::steady_clock::time_point const t0
+				{ std::chrono::steady_clock::now() };
+			func();
+			std::chrono::steady_clock::time_point const t1
+				{ std::chrono::steady_clock::now() };
+			minSec = std::min
+				(minSec, std::chrono::duration<double>(t1 - t0).count());
+		}
+		return minSec;
+	}
+
+	//! JSON object describing one loader timing
+	std::string
+	jsonFor
+		( std::string const & name
+		, std::size_t const & numSen
+		, std::size_t const & numBytes
+		, std::size_t const & numLoaded
+		, double const & seconds
+		)
+	{
+		std::ostringstream oss;
+		oss << "{ \"name\": \"" << name << "\""
+			<< ", \"numSen\": " << numSen
+			<< ", \"numLoaded\": " << numLoaded
+			<< ", \"bytes\": " << numBytes
+			<< ", \"seconds\": " << seconds
+			<< ", \"MBytesPerSec\": " << (1.e-6 * numBytes / seconds)
+			<< ", \"sensorsPerSec\": " << (numSen / seconds)
+			<< " }";
+		return oss.str();
+	}
+
+} // [anon]
+
+
+//! Time text file loaders.
+int
+main
+	( int argc
+	, char * argv[]
+	)
+{
+	std::size_t numSen{ 100000u };
+	std::size_t numRep{ 3u };
+	if (1 < argc)
+	{
+		numSen = std::strtoul(argv[1], nullptr, 10);
+	}
+	if (2 < argc)
+	{
+		numRep = std::strtoul(argv[2], nullptr, 10);
+	}
+
+	std::filesystem::path const tmpDir
+		{ std::filesystem::temp_directory_path() };
+	std::filesystem::path const pgPath{ tmpDir / "bench_io_PG.txt" };
+	std::filesystem::path const eoPath{ tmpDir / "bench_io_EO.txt" };
+	std::string const pgText{ textFor(numSen, false) };
+	std::string const eoText{ textFor(numSen, true) };
+	std::ofstream(pgPath) << pgText;
+	std::ofstream(eoPath) << eoText;
+
+	std::size_t numPGs{ 0u };
+	double const pgSec
+		{ minSecondsFor
+			( [&] ()
+				{
+					std::ifstream ifs(pgPath);
+					numPGs = om::loadParmGroups(ifs).size();
+				}
+			, numRep
+			)
+		};
+
+	std::size_t numEOs{ 0u };
+	double const eoSec
+		{ minSecondsFor
+			( [&] ()
+				{
+					std::ifstream ifs(eoPath);
+					numEOs = om::loadIndEOs(ifs).size();
+				}
+			, numRep
+			)
+		};
+
+	std::size_t numFilePGs{ 0u };
+	double const pgFileSec
+		{ minSecondsFor
+			( [&] ()
+				{
+					numFilePGs = om::loadParmGroupsFile(pgPath).size();
+				}
+			, numRep
+			)
+		};
+
+	std::size_t numFileEOs{ 0u };
+	double const eoFileSec
+		{ minSecondsFor
+			( [&] ()
+				{
+					numFileEOs = om::loadIndEOsFile(eoPath).size();
+				}
+			, numRep
+			)
+		};
+
+	std::size_t const pgSize{ pgText.size() };
+	std::size_t const eoSize{ eoText.size() };
+	std::cout
+		<< "[\n"
+		<< jsonFor("loadParmGroups", numSen, pgSize, numPGs, pgSec)
+		<< ",\n"
+		<< jsonFor("loadIndEOs", numSen, eoSize, numEOs, eoSec)
+		<< ",\n"
+		<< jsonFor("loadParmGroupsFile", numSen, pgSize, numFilePGs, pgFileSec)
+		<< ",\n"
+		<< jsonFor("loadIndEOsFile", numSen, eoSize, numFileEOs, eoFileSec)
+		<< "\n]\n";
+
+	std::filesystem::remove(pgPath);
+	std::filesystem::remove(eoPath);
+	return 0;
+}
+
@@ -36,11 +36,19 @@ Example:
 
 
 #include "Convention.hpp"
+#include "KdTree.hpp"
+#include "OriBatch.hpp"
 #include "Orientation.hpp"
+#include "Parallel.hpp"
+#include "Profile.hpp"
 
 #include <Engabra>
 #include <Rigibra>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -61,8 +69,8 @@ namespace om
 		{
 			// transform orthogonal basis and sum square resulting differences
 			Vector const got1{ ori(e1) };
-			Vector const got2{ ori(e1) };
-			Vector const got3{ ori(e1) };
+			Vector const got2{ ori(e2) };
+			Vector const got3{ ori(e3) };
 			double const eSq1{ magSq(got1 - e1) };
 			double const eSq2{ magSq(got2 - e2) };
 			double const eSq3{ magSq(got3 - e3) };
@@ -93,6 +101,7 @@ namespace om
 		{
 			// form relative transform between two orientations
 			SenOri const & oriXw1{ inverse(ori1wX) };
+			prof::count(prof::Counter::Inverse);
 			SenOri const ori2w1{ ori2wX * oriXw1 };
 			// assess rmse error in transforming basis vectors
 			rmse = basisTransformRMSE(ori2w1);
@@ -100,212 +109,2009 @@ namespace om
 		return rmse;
 	}
 
+	/*! \brief Statistic representing rotation-only error of ori.
+	 *
+	 * Similar to basisTransformRMSE() but with the translation part
+	 * of ori removed, i.e. only the attitude of ori contributes.
+	 */
+	inline
+	double
+	basisRotationRMSE
+		( SenOri const & ori
+		)
+	{
+		using namespace engabra::g3;
+		double rmse{ null<double>() };
+		if (isValid(ori))
+		{
+			// rotate orthogonal basis and sum square resulting differences
+			Vector const got0{ ori(Vector{ 0., 0., 0. }) };
+			Vector const got1{ ori(e1) - got0 };
+			Vector const got2{ ori(e2) - got0 };
+			Vector const got3{ ori(e3) - got0 };
+			double const eSq1{ magSq(got1 - e1) };
+			double const eSq2{ magSq(got2 - e2) };
+			double const eSq3{ magSq(got3 - e3) };
+
+			// Statistical degrees of freedom
+			constexpr double numComp{ 9. }; // 9 components being compared
+			constexpr double numParm{ 3. }; // three angles
+			constexpr double statDof{ numComp - numParm };
+
+			double sse{ (1./statDof) * (eSq1 + eSq2 + eSq3) };
+			rmse = std::sqrt(sse);
+		}
+		return rmse;
+	}
+
+	//! Statistic representing rotation-only error between ori{1,2}.
+	inline
+	double
+	rmseRotationErrorBetween
+		( SenOri const & ori1wX
+		, SenOri const & ori2wX
+		)
+	{
+		double rmse{ engabra::g3::null<double>() };
+		using namespace engabra::g3;
+		using namespace rigibra;
+		if (isValid(ori1wX) && isValid(ori2wX))
+		{
+			// form relative transform between two orientations
+			SenOri const & oriXw1{ inverse(ori1wX) };
+			prof::count(prof::Counter::Inverse);
+			SenOri const ori2w1{ ori2wX * oriXw1 };
+			// assess rmse error in rotating basis vectors
+			rmse = basisRotationRMSE(ori2w1);
+		}
+		return rmse;
+	}
+
+	/*! \brief Same statistic as basisTransformRMSE() but in closed form.
+	 *
+	 * The transform, ori, maps vector v into ori(v) = R(v - t), with
+	 * t the location and R the rotation of the (unitary) spinor having
+	 * scalar part c and bivector (dual) components b. With s=(1,1,1),
+	 * the sum of squared basis differences, sum{|ori(e_k) - e_k|^2},
+	 * evaluates to:
+	 * \verbatim
+	 *   8|b|^2 + 3|t|^2 - 4c[s,b,t] + 4(s.b)(b.t) - 4|b|^2(s.t)
+	 * \endverbatim
+	 * where [s,b,t] is the scalar triple product s.(bxt). No vectors
+	 * are transformed, and only a few dozen flops are required.
+	 */
+	inline
+	double
+	rotorTransformRMSE
+		( SenOri const & ori
+		)
+	{
+		using namespace engabra::g3;
+		double rmse{ null<double>() };
+		if (isValid(ori))
+		{
+			// (same arithmetic as the OriBatch kernels)
+			rmse = rmseRotorFor(OriParts::from(ori));
+		}
+		return rmse;
+	}
+
+	//! Statistic as rmseBasisErrorBetween() but using rotorTransformRMSE().
+	inline
+	double
+	rmseRotorErrorBetween
+		( SenOri const & ori1wX
+		, SenOri const & ori2wX
+		)
+	{
+		double rmse{ engabra::g3::null<double>() };
+		using namespace engabra::g3;
+		using namespace rigibra;
+		if (isValid(ori1wX) && isValid(ori2wX))
+		{
+			// closed form rmse error of relative rotor and translation
+			// (same arithmetic as the OriBatch kernels)
+			rmse = rmseRotorBetween
+				(OriParts::from(ori1wX), OriParts::from(ori2wX));
+		}
+		return rmse;
+	}
+
+	//! Fit metric policy: transform basis vectors (rmseBasisErrorBetween).
+	struct BasisMetric
+	{
+		//! Fit error statistic between two orientations.
+		inline
+		static
+		double
+		rmseBetween
+			( SenOri const & ori1wX
+			, SenOri const & ori2wX
+			)
+		{
+			return rmseBasisErrorBetween(ori1wX, ori2wX);
+		}
+
+		//! Fit error statistic between oris1wX[ndx] and ori2wX.
+		inline
+		static
+		double
+		rmseBetween
+			( OriBatch const & oris1wX
+			, std::size_t const & ndx
+			, SenOri const & ori2wX
+			)
+		{
+			return rmseBasisErrorBetween(oris1wX.oriAt(ndx), ori2wX);
+		}
+
+		//! Add rmseBetween(oris1wX, k, ori2wX) into sums[k] (k in [beg,end))
+		inline
+		static
+		void
+		addErrorsInto
+			( double * const & sums
+			, OriBatch const & oris1wX
+			, SenOri const & ori2wX
+			, std::size_t const & ndxBeg
+			, std::size_t const & ndxEnd
+			)
+		{
+			for (std::size_t kNdx{ndxBeg} ; kNdx < ndxEnd ; ++kNdx)
+			{
+				sums[kNdx] += rmseBetween(oris1wX, kNdx, ori2wX);
+			}
+		}
+
+	}; // BasisMetric
+
+	//! Fit metric policy: closed form (rmseRotorErrorBetween).
+	struct RotorMetric
+	{
+		//! Fit error statistic between two orientations.
+		inline
+		static
+		double
+		rmseBetween
+			( SenOri const & ori1wX
+			, SenOri const & ori2wX
+			)
+		{
+			return rmseRotorErrorBetween(ori1wX, ori2wX);
+		}
+
+		//! Fit error statistic between oris1wX[ndx] and ori2wX.
+		inline
+		static
+		double
+		rmseBetween
+			( OriBatch const & oris1wX
+			, std::size_t const & ndx
+			, SenOri const & ori2wX
+			)
+		{
+			return rmseRotorBetween
+				(oris1wX.partsAt(ndx), OriParts::from(ori2wX));
+		}
+
+		//! Add rmseBetween(oris1wX, k, ori2wX) into sums[k] (vectorized)
+		inline
+		static
+		void
+		addErrorsInto
+			( double * const & sums
+			, OriBatch const & oris1wX
+			, SenOri const & ori2wX
+			, std::size_t const & ndxBeg
+			, std::size_t const & ndxEnd
+			)
+		{
+			addRmseRotorErrors
+				(sums, oris1wX, OriParts::from(ori2wX), ndxBeg, ndxEnd);
+		}
+
+	}; // RotorMetric
+
+	//! Fit metric policy used by default for all fit error evaluations.
+	using FitMetric = RotorMetric;
+
 	/*! \brief Relative orientation between two ParmGroups.
 	 *
-	 * Each ParmGroup argument is converted to a SenOri using the
-	 * same Convention. The two individual orientations are then
-	 * combined into a relative orientation of "2" with respect to "1".
+	 * Each ParmGroup argument is converted to a SenOri using the
+	 * same Convention. The two individual orientations are then
+	 * combined into a relative orientation of "2" with respect to "1".
+	 */
+	inline
+	SenOri
+	relativeOrientationFor
+		( ParmGroup const & pg1
+		, ParmGroup const & pg2
+		, Convention const & convention
+		)
+	{
+		// generate forward transforms internal to black box frame
+		SenOri const ori1wB{ convention.transformFor(pg1) };
+		SenOri const ori2wB{ convention.transformFor(pg2) };
+		// compute relative orientation in black box frame
+		SenOri const oriBw1{ inverse(ori1wB) };
+		prof::count(prof::Counter::Inverse);
+		SenOri const roBox{ ori2wB * oriBw1 };
+		return roBox;
+	}
+
+	//! Relative orientation as above, but using precomputed attitudes.
+	inline
+	SenOri
+	relativeOrientationFor
+		( AttitudeTable const & table1
+		, AttitudeTable const & table2
+		, Convention const & convention
+		)
+	{
+		// generate forward transforms internal to black box frame
+		SenOri const ori1wB{ table1.transformFor(convention) };
+		SenOri const ori2wB{ table2.transformFor(convention) };
+		// compute relative orientation in black box frame
+		SenOri const oriBw1{ inverse(ori1wB) };
+		prof::count(prof::Counter::Inverse);
+		SenOri const roBox{ ori2wB * oriBw1 };
+		return roBox;
+	}
+
+	/*! \brief Box transforms of all sensors for one convention at a time.
+	 *
+	 * Relative orientations between all pairs of N sensors involve only
+	 * N transforms (and N inverses) for each convention. These are
+	 * evaluated once by setConvention() after which any pair of them
+	 * may be combined by relativeOrientation(). Sensor index values
+	 * are SenNdx values (e.g. positions in a (SenKey sorted) map).
+	 */
+	struct SensorTransforms
+	{
+		//! Attitude table for each sensor (null for absent sensors).
+		std::vector<AttitudeTable const *> thePtTables{};
+
+		//! Sensor w.r.t. Box transform for current convention.
+		std::vector<SenOri> theOriSwBs{};
+
+		//! Inverse (Box w.r.t. Sensor) of each theOriSwBs transform.
+		std::vector<SenOri> theOriBwSs{};
+
+		//! Instance for sensors in keyTables (before setConvention()).
+		inline
+		static
+		SensorTransforms
+		from
+			( std::map<SenKey, AttitudeTable> const & keyTables
+			)
+		{
+			SensorTransforms xfms;
+			xfms.thePtTables.reserve(keyTables.size());
+			for (std::map<SenKey, AttitudeTable>::value_type
+				const & keyTable : keyTables)
+			{
+				xfms.thePtTables.emplace_back(&(keyTable.second));
+			}
+			xfms.theOriSwBs.reserve(keyTables.size());
+			xfms.theOriBwSs.reserve(keyTables.size());
+			return xfms;
+		}
+
+		//! Instance for tables in SenNdx order (invalid tables are absent).
+		inline
+		static
+		SensorTransforms
+		from
+			( std::vector<AttitudeTable> const & tables
+			)
+		{
+			SensorTransforms xfms;
+			xfms.thePtTables.reserve(tables.size());
+			for (AttitudeTable const & table : tables)
+			{
+				AttitudeTable const * ptTable{ nullptr };
+				if (table.isValid())
+				{
+					ptTable = &table;
+				}
+				xfms.thePtTables.emplace_back(ptTable);
+			}
+			xfms.theOriSwBs.reserve(tables.size());
+			xfms.theOriBwSs.reserve(tables.size());
+			return xfms;
+		}
+
+		//! Evaluate transform (and inverse) of each sensor for convention.
+		inline
+		void
+		setConvention
+			( Convention const & convention
+			)
+		{
+			theOriSwBs.clear();
+			theOriBwSs.clear();
+			for (AttitudeTable const * const & ptTable : thePtTables)
+			{
+				SenOri oriSwB{};
+				if (ptTable)
+				{
+					oriSwB = ptTable->transformFor(convention);
+				}
+				theOriSwBs.emplace_back(oriSwB);
+				theOriBwSs.emplace_back(inverse(oriSwB));
+			}
+			prof::count(prof::Counter::Inverse, thePtTables.size());
+		}
+
+		//! Same as relativeOrientationFor() for sensor pair (ndx1,ndx2).
+		inline
+		SenOri
+		relativeOrientation
+			( std::size_t const & ndx1
+			, std::size_t const & ndx2
+			) const
+		{
+			return (theOriSwBs[ndx2] * theOriBwSs[ndx1]);
+		}
+
+	}; // SensorTransforms
+
+	/*! \brief Sum-squared-errors (SSE) (across all ROs) by each convention.
+	 *
+	 * For each Convention (from allCons), compute the root average
+	 * squared error (RASE) associated with each RO. Sum these per-RO
+	 * RASE values into the SSE values for that Convention.
+	 *
+	 * The return collection contains SSE values in 1:1 correspondence
+	 * with the convention cases in allCons.
+	 *
+	 * The attitudes for each ParmGroup are computed once (one for each
+	 * ConventionAngle) and then looked up for every Convention. For
+	 * each Convention, every sensor transform (and its inverse) is
+	 * evaluated once (ref SensorTransforms) and then combined for
+	 * each of the ROs.
+	 *
+	 * The per-convention sums are independent of each other. The
+	 * allCons collection is split into numThreads blocks that are
+	 * evaluated concurrently. Each sum is accumulated in the same
+	 * (relKeyOris) order regardless of numThreads, so that results
+	 * are identical for any thread count.
+	 */
+	template <typename Metric = FitMetric>
+	inline
+	std::vector<double>
+	fitErrorByConvention
+		( std::map<SenKey, ParmGroup> const & keyGroups
+		, std::map<KeyPair, SenOri> const & relKeyOris
+		, std::vector<Convention> const & allCons
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		// accumulation of fit errors, one for each convention in allCons
+		std::vector<double> sumFitErrors(allCons.size(), 0.);
+
+		// attitudes (for all angle conventions) for each parameter group
+		std::map<SenKey, AttitudeTable> const keyTables
+			{ attitudeTablesFor(keyGroups) };
+
+		// sensor indices for each relative orientation (both keys present)
+		std::vector<NdxRelOri> const nnROs
+			{ ndxRelOrisFor(keyTables, relKeyOris) };
+
+		// compute fit scores for one block of conventions
+		auto const evalBlock
+			{ [&sumFitErrors, &nnROs, &keyTables, &allCons]
+				( std::size_t const ndxBeg
+				, std::size_t const ndxEnd
+				)
+			{
+				SensorTransforms xfms{ SensorTransforms::from(keyTables) };
+
+				// Box ROs for a sub-block of conventions (batch for each RO)
+				constexpr std::size_t sSubSize{ 256u };
+				std::vector<OriBatch> roBoxBatches
+					(nnROs.size(), OriBatch::withSize(sSubSize));
+
+				for (std::size_t subBeg{ndxBeg} ; subBeg < ndxEnd
+					; subBeg += sSubSize)
+				{
+					std::size_t const subEnd
+						{ std::min(subBeg + sSubSize, ndxEnd) };
+					for (std::size_t cNdx{subBeg} ; cNdx < subEnd ; ++cNdx)
+					{
+						// each sensor transform evaluated once per convention
+						xfms.setConvention(allCons[cNdx]);
+						for (std::size_t rNdx{0u} ; rNdx < nnROs.size()
+							; ++rNdx)
+						{
+							NdxRelOri const & nnRO = nnROs[rNdx];
+							roBoxBatches[rNdx].setParts
+								( cNdx - subBeg
+								, OriParts::from
+									(xfms.relativeOrientation
+										(nnRO.theNdx1, nnRO.theNdx2)
+									)
+								);
+						}
+					}
+
+					// accumulate consistency score for each RO
+					// (many conventions per instruction, ref OriBatch)
+					for (std::size_t rNdx{0u} ; rNdx < nnROs.size() ; ++rNdx)
+					{
+						Metric::addErrorsInto
+							( sumFitErrors.data() + subBeg
+							, roBoxBatches[rNdx]
+							, nnROs[rNdx].theRelOri
+							, 0u
+							, subEnd - subBeg
+							);
+					}
+				}
+			}
+			};
+
+		par::forEachBlock(allCons.size(), numThreads, evalBlock);
+
+		return sumFitErrors;
+	}
+
+	/*! \brief Groups of conventions producing identical Box transforms.
+	 *
+	 * For generic ParmGroup values, every convention produces a unique
+	 * transform (ref test_Convention). However, specific data values
+	 * (e.g. zero angles, or repeated angle or distance magnitudes)
+	 * can make several conventions produce exactly the same transform
+	 * for every one of the ParmGroups. E.g. for a zero angle the sign
+	 * convention is irrelevant, and for equal angle sizes the index
+	 * permutations swapping them are irrelevant.
+	 *
+	 * Conventions are grouped into classes for which all ParmGroups
+	 * transform identically. Transforms are compared (via signatures)
+	 * at resolution sRelQuantum relative to the ParmGroup distances,
+	 * such that classes do not depend on computation noise (e.g. on
+	 * the evaluation order of a math library). Fit computations need
+	 * only be performed for one representative of each class after
+	 * which the results may be fanned back out to every member, e.g.
+	 * via fannedOut(). Index values remain those of allCons.
+	 */
+	struct ConventionClasses
+	{
+		//! Index (into allCons) of the representative for each class.
+		std::vector<std::size_t> theRepNdxs{};
+
+		//! Class (index into theRepNdxs) for each member of allCons.
+		std::vector<std::size_t> theClassNdxs{};
+
+		//! Resolution of signature values (relative to data magnitude).
+		static constexpr double sRelQuantum{ 1./4294967296. }; // 2^-32
+
+		//! Signature quantum for (ParmGroup distances of) table.
+		inline
+		static
+		double
+		quantumFor
+			( AttitudeTable const & table
+			)
+		{
+			double maxMag{ 1. };
+			for (double const & dist : table.theParmGroup.theDistances)
+			{
+				maxMag = std::max(maxMag, std::abs(dist));
+			}
+			return (sRelQuantum * maxMag);
+		}
+
+		/*! \brief Append (quantized) images of origin and basis under xfm.
+		 *
+		 * Values are rounded to multiples of quantum such that transforms
+		 * which differ only by computation noise (e.g. a few ulps from
+		 * a different evaluation order) have the same signature - unless
+		 * a value happens to be within the noise of a rounding boundary.
+		 */
+		inline
+		static
+		void
+		appendSignature
+			( std::vector<double> * const & ptSignature
+			, SenOri const & xfm
+			, double const & quantum
+			)
+		{
+			using namespace engabra::g3;
+			Vector const zero{ 0., 0., 0. };
+			for (Vector const & vec : { zero, e1, e2, e3 })
+			{
+				Vector const img{ xfm(vec) };
+				for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+				{
+					ptSignature->emplace_back(std::round(img[kk] / quantum));
+				}
+			}
+		}
+
+		//! Classes of allCons conventions that transform (valid) tables alike.
+		inline
+		static
+		ConventionClasses
+		from
+			( std::vector<AttitudeTable> const & tables
+			, std::vector<Convention> const & allCons
+			)
+		{
+			ConventionClasses classes;
+			classes.theClassNdxs.reserve(allCons.size());
+
+			std::vector<double> quantums;
+			quantums.reserve(tables.size());
+			for (AttitudeTable const & table : tables)
+			{
+				quantums.emplace_back(quantumFor(table));
+			}
+
+			// signature: images of origin and basis for all ParmGroups
+			using Signature = std::vector<double>;
+			std::map<Signature, std::size_t> classForSigs;
+			Signature signature;
+			signature.reserve(12u * tables.size());
+			for (std::size_t cNdx{0u} ; cNdx < allCons.size() ; ++cNdx)
+			{
+				signature.clear();
+				for (std::size_t tNdx{0u} ; tNdx < tables.size() ; ++tNdx)
+				{
+					AttitudeTable const & table = tables[tNdx];
+					if (table.isValid())
+					{
+						appendSignature
+							( &signature
+							, table.transformFor(allCons[cNdx])
+							, quantums[tNdx]
+							);
+					}
+				}
+
+				// first convention with a new signature represents class
+				std::pair<std::map<Signature, std::size_t>::iterator, bool>
+					const result
+					{ classForSigs.emplace
+						(signature, classes.theRepNdxs.size())
+					};
+				if (result.second)
+				{
+					classes.theRepNdxs.emplace_back(cNdx);
+				}
+				classes.theClassNdxs.emplace_back(result.first->second);
+			}
+
+			return classes;
+		}
+
+		//! Classes of allCons conventions that transform keyGroups alike.
+		inline
+		static
+		ConventionClasses
+		from
+			( std::map<SenKey, ParmGroup> const & keyGroups
+			, std::vector<Convention> const & allCons
+			)
+		{
+			SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+			return from(attitudeTablesFor(registry, keyGroups), allCons);
+		}
+
+		//! Number of (distinct) classes
+		inline
+		std::size_t
+		numClasses
+			() const
+		{
+			return theRepNdxs.size();
+		}
+
+		//! Number of conventions (members over all classes)
+		inline
+		std::size_t
+		numMembers
+			() const
+		{
+			return theClassNdxs.size();
+		}
+
+		//! Representative conventions (one from allCons for each class)
+		inline
+		std::vector<Convention>
+		representatives
+			( std::vector<Convention> const & allCons
+			) const
+		{
+			std::vector<Convention> reps;
+			reps.reserve(theRepNdxs.size());
+			for (std::size_t const & repNdx : theRepNdxs)
+			{
+				reps.emplace_back(allCons[repNdx]);
+			}
+			return reps;
+		}
+
+		//! Values for every member - i.e. copied from its class value.
+		inline
+		std::vector<double>
+		fannedOut
+			( std::vector<double> const & classValues
+			) const
+		{
+			std::vector<double> memberValues;
+			memberValues.reserve(theClassNdxs.size());
+			for (std::size_t const & classNdx : theClassNdxs)
+			{
+				memberValues.emplace_back(classValues[classNdx]);
+			}
+			return memberValues;
+		}
+
+		//! Members (indices into allCons) of each class (in class order).
+		inline
+		std::vector<std::vector<std::size_t> >
+		membersByClass
+			() const
+		{
+			std::vector<std::vector<std::size_t> > members(numClasses());
+			for (std::size_t cNdx{0u} ; cNdx < theClassNdxs.size() ; ++cNdx)
+			{
+				members[theClassNdxs[cNdx]].emplace_back(cNdx);
+			}
+			return members;
+		}
+
+	}; // ConventionClasses
+
+	/*! \brief Box frame relative orientations for all conventions.
+	 *
+	 * The Box ROs depend only on the (Box) ParmGroup values and on
+	 * the conventions, i.e. they are the same for every trial of the
+	 * independent (Ind) data. This table is intended to be constructed
+	 * once, and then used (via fitErrorByConvention() overload) for
+	 * comparison with any number of independent RO collections.
+	 *
+	 * Conventions which produce identical Box transforms (ref
+	 * ConventionClasses) are stored (and evaluated) only once.
+	 *
+	 * Storage is (number of key pairs) * (number of classes) times
+	 * sizeof(SenOri), e.g. about 65 MBytes for 7 sensors and 55296
+	 * distinct conventions.
+	 */
+	struct BoxRelOriTable
+	{
+		//! Number of conventions (from allCons) used to generate table.
+		std::size_t theNumConventions{ 0u };
+
+		//! Classes of allCons that produce identical Box ROs.
+		ConventionClasses theClasses{};
+
+		//! Sensors (SenNdx values) for which ROs are tabulated.
+		SenRegistry theRegistry{};
+
+		//! ROs (1:1 with theClasses) at [ndx1*N+ndx2] for (ndx1<ndx2).
+		std::vector<OriBatch> thePairBoxROs{};
+
+		/*! \brief Table with Box ROs for all sensor pairs and conventions.
+		 *
+		 * The tables are in SenNdx order of the registry. ROs are formed
+		 * (as for relativeOrientationBetweens()) for each pair of valid
+		 * tables with (ndx1 < ndx2), i.e. with (key1 < key2). Sensor
+		 * transforms are evaluated once per convention and are combined
+		 * (over all conventions at once) with inverseOf() and composedOf().
+		 */
+		inline
+		static
+		BoxRelOriTable
+		from
+			( SenRegistry const & registry
+			, std::vector<AttitudeTable> const & tables
+			, std::vector<Convention> const & allCons
+			)
+		{
+			BoxRelOriTable table;
+			table.theNumConventions = allCons.size();
+			table.theRegistry = registry;
+			table.theClasses = ConventionClasses::from(tables, allCons);
+			std::vector<Convention> const repCons
+				{ table.theClasses.representatives(allCons) };
+
+			// sensor index pairs (with ndx1 < ndx2) for valid tables
+			std::size_t const numSen{ tables.size() };
+			using NdxPair = std::pair<SenNdx, SenNdx>;
+			std::vector<NdxPair> ndxPairs;
+			for (SenNdx ndx1{0u} ; ndx1 < numSen ; ++ndx1)
+			{
+				for (SenNdx ndx2{ndx1 + 1u} ; ndx2 < numSen ; ++ndx2)
+				{
+					if (tables[ndx1].isValid() && tables[ndx2].isValid())
+					{
+						ndxPairs.emplace_back(ndx1, ndx2);
+					}
+				}
+			}
+
+			// evaluate each sensor transform once per convention
+			std::vector<OriBatch> oriSwBs(numSen);
+			std::vector<OriBatch> oriBwSs(numSen);
+			for (SenNdx ndx{0u} ; ndx < numSen ; ++ndx)
+			{
+				AttitudeTable const & attTable = tables[ndx];
+				if (attTable.isValid())
+				{
+					OriBatch & oris = oriSwBs[ndx];
+					oris.reserve(repCons.size());
+					for (Convention const & convention : repCons)
+					{
+						oris.emplace_back(attTable.transformFor(convention));
+					}
+					oriBwSs[ndx] = inverseOf(oris);
+				}
+			}
+
+			// combine sensor transforms (for all conventions) per pair
+			table.thePairBoxROs.resize(numSen * numSen);
+			for (NdxPair const & ndxPair : ndxPairs)
+			{
+				table.thePairBoxROs[ndxPair.first*numSen + ndxPair.second]
+					= composedOf
+						(oriSwBs[ndxPair.second], oriBwSs[ndxPair.first]);
+			}
+
+			return table;
+		}
+
+		//! Table (as above) for all key pairs (with key1 < key2).
+		inline
+		static
+		BoxRelOriTable
+		from
+			( std::map<SenKey, ParmGroup> const & keyGroups
+			, std::vector<Convention> const & allCons
+			)
+		{
+			SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+			return from
+				(registry, attitudeTablesFor(registry, keyGroups), allCons);
+		}
+
+		//! Box ROs (for all classes) for sensor pair or null if not found.
+		inline
+		OriBatch const *
+		boxROsFor
+			( SenNdx const & ndx1
+			, SenNdx const & ndx2
+			) const
+		{
+			OriBatch const * ptROs{ nullptr };
+			std::size_t const numSen{ theRegistry.size() };
+			if ((ndx1 < numSen) && (ndx2 < numSen))
+			{
+				OriBatch const & roBoxes
+					= thePairBoxROs[ndx1*numSen + ndx2];
+				if (! roBoxes.empty())
+				{
+					ptROs = &roBoxes;
+				}
+			}
+			return ptROs;
+		}
+
+		//! Box ROs (for all classes) for keyPair or null if not found.
+		inline
+		OriBatch const *
+		boxROsFor
+			( KeyPair const & keyPair
+			) const
+		{
+			return boxROsFor
+				( theRegistry.ndxFor(keyPair.key1())
+				, theRegistry.ndxFor(keyPair.key2())
+				);
+		}
+
+	}; // BoxRelOriTable
+
+	/*! \brief Sum-squared-errors by convention class using precomputed Box ROs.
+	 *
+	 * Only the comparisons of the nnROs with the Box ROs are computed,
+	 * and only once for each class of identical conventions (in order
+	 * of boxTable.theClasses). As for the functions above, evaluations
+	 * are split into numThreads blocks which are evaluated concurrently.
+	 *
+	 * The nnROs (flat RO collection, e.g. from relativeOrientationBetweens())
+	 * sensor indices are SenNdx values of boxTable.theRegistry.
+	 */
+	template <typename Metric = FitMetric>
+	inline
+	std::vector<double>
+	fitErrorByClass
+		( BoxRelOriTable const & boxTable
+		, std::vector<NdxRelOri> const & nnROs
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		prof::StageTimer const timer(prof::Stage::Fit);
+
+		// accumulation of fit errors, one for each class of conventions
+		std::size_t const numClasses{ boxTable.theClasses.numClasses() };
+		std::vector<double> sumClassErrors(numClasses, 0.);
+
+		// gather Box RO collections associated with each relative orientation
+		using BoxesRO = std::pair<OriBatch const *, SenOri const *>;
+		std::vector<BoxesRO> boxesROs;
+		boxesROs.reserve(nnROs.size());
+		for (NdxRelOri const & nnRO : nnROs)
+		{
+			OriBatch const * const ptBoxROs
+				{ boxTable.boxROsFor(nnRO.theNdx1, nnRO.theNdx2) };
+			if (ptBoxROs)
+			{
+				boxesROs.emplace_back(ptBoxROs, &(nnRO.theRelOri));
+			}
+		}
+
+		// compute fit scores for one block of classes
+		auto const evalBlock
+			{ [&sumClassErrors, &boxesROs]
+				( std::size_t const ndxBeg
+				, std::size_t const ndxEnd
+				)
+			{
+				// (many classes per instruction, ref OriBatch)
+				for (BoxesRO const & boxesRO : boxesROs)
+				{
+					Metric::addErrorsInto
+						( sumClassErrors.data()
+						, *(boxesRO.first)
+						, *(boxesRO.second)
+						, ndxBeg
+						, ndxEnd
+						);
+				}
+			}
+			};
+
+		par::forEachBlock(numClasses, numThreads, evalBlock);
+
+		return sumClassErrors;
+	}
+
+	/*! \brief Sum-squared-errors by convention using precomputed Box ROs.
+	 *
+	 * Same result as fitErrorByConvention(keyGroups, relKeyOris, allCons)
+	 * with boxTable from BoxRelOriTable::from(keyGroups, allCons). The
+	 * fitErrorByClass() sums are fanned out to all of the conventions.
+	 */
+	inline
+	std::vector<double>
+	fitErrorByConvention
+		( BoxRelOriTable const & boxTable
+		, std::vector<NdxRelOri> const & nnROs
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		return boxTable.theClasses.fannedOut
+			(fitErrorByClass(boxTable, nnROs, numThreads));
+	}
+
+	//! Sum-squared-errors by convention (as above) for keyed ROs.
+	inline
+	std::vector<double>
+	fitErrorByConvention
+		( BoxRelOriTable const & boxTable
+		, std::map<KeyPair, SenOri> const & relKeyOris
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		return fitErrorByConvention
+			( boxTable
+			, ndxRelOrisFor(boxTable.theRegistry, relKeyOris)
+			, numThreads
+			);
+	}
+
+
+	//! Pair of (fitErrorValue, ConventionArrayIndex))
+	using FitNdxPair = std::pair<double, std::size_t>;
+
+	/*! \brief Normalized fit errors paired with their array index.
+	 *
+	 * Each sumFitErrors value is divided by numRelOris (the number of
+	 * ROs contributing to the sum) and paired with its array offset.
+	 */
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsFrom
+		( std::vector<double> const & sumFitErrors
+		, std::size_t const & numRelOris
+		)
+	{
+		std::vector<FitNdxPair> allFitConPairs;
+
+		// normalize the scores by number of ROs
+		double const scale{ 1./static_cast<double>(numRelOris) };
+
+		// associate the errors with their collection index
+		std::size_t const numFit{ sumFitErrors.size() };
+		allFitConPairs.reserve(numFit);
+		for (std::size_t nn{0u} ; nn < numFit ; ++nn)
+		{
+			allFitConPairs.emplace_back
+				(std::make_pair(scale*sumFitErrors[nn], nn));
+		}
+
+		return allFitConPairs;
+	}
+
+	/*! \brief Streaming selection of the best few (and worst) FitNdxPair.
+	 *
+	 * Values are fed (one at a time) to consider(). The theNumBest
+	 * smallest values, and the single largest value, are retained.
+	 * Ordering is that of FitNdxPair (i.e. fit error, then index), so
+	 * that the results are the same as the first and last entries
+	 * of the fed values after sorting - but without storing them.
+	 *
+	 * Separate instances (e.g. one per thread for different index
+	 * ranges) may be combined with merge(). Since the ordering is
+	 * strict (indices are unique) the merged result does not depend
+	 * on how the values were distributed among instances.
+	 */
+	struct FitNdxSelector
+	{
+		//! Number of (smallest) values to retain.
+		std::size_t theNumBest{ 2u };
+
+		//! Smallest values considered so far (sorted best first).
+		std::vector<FitNdxPair> theBests{};
+
+		//! Largest value considered so far (if 0 < theNumSeen).
+		FitNdxPair theWorst{ engabra::g3::null<double>(), 0u };
+
+		//! Number of values that have been considered.
+		std::size_t theNumSeen{ 0u };
+
+		//! True if theWorst is only a lower bound (ref considerAtLeast()).
+		bool theIsWorstBound{ false };
+
+		//! Empty instance that retains numBest smallest values.
+		inline
+		static
+		FitNdxSelector
+		withNumBest
+			( std::size_t const & numBest
+			)
+		{
+			FitNdxSelector selector;
+			selector.theNumBest = numBest;
+			selector.theBests.reserve(numBest + 1u);
+			return selector;
+		}
+
+		//! Update best and worst values to include fitNdx.
+		inline
+		void
+		consider
+			( FitNdxPair const & fitNdx
+			)
+		{
+			if ((0u == theNumSeen) || (theWorst < fitNdx))
+			{
+				theWorst = fitNdx;
+			}
+			++theNumSeen;
+
+			// insert (in order) if better than the current last best
+			if ((theBests.size() < theNumBest) || (fitNdx < theBests.back()))
+			{
+				theBests.insert
+					( std::upper_bound
+						(theBests.begin(), theBests.end(), fitNdx)
+					, fitNdx
+					);
+				if (theNumBest < theBests.size())
+				{
+					theBests.pop_back();
+				}
+			}
+		}
+
+		/*! \brief Include a value known only to be at least as large as fitNdx.
+		 *
+		 * E.g. a convention that is abandoned (as hopeless) during a
+		 * branch-and-bound search. Such a value can not be among the
+		 * best, but it is counted and may update (the lower bound of)
+		 * theWorst.
+		 */
+		inline
+		void
+		considerAtLeast
+			( FitNdxPair const & fitNdx
+			)
+		{
+			if ((0u == theNumSeen) || (theWorst < fitNdx))
+			{
+				theWorst = fitNdx;
+			}
+			++theNumSeen;
+			theIsWorstBound = true;
+		}
+
+		//! Largest error value that could still be among the best.
+		inline
+		double
+		bound
+			() const
+		{
+			double bnd{ std::numeric_limits<double>::infinity() };
+			if ((0u < theNumBest) && (theNumBest == theBests.size()))
+			{
+				bnd = theBests.back().first;
+			}
+			return bnd;
+		}
+
+		//! Combine the values considered by other into this instance.
+		inline
+		void
+		merge
+			( FitNdxSelector const & other
+			)
+		{
+			if (0u < other.theNumSeen)
+			{
+				// (other worst is also among other bests if few were seen)
+				FitNdxPair const worst
+					{ ((0u == theNumSeen) || (theWorst < other.theWorst))
+						? other.theWorst
+						: theWorst
+					};
+				std::size_t const numSeen{ theNumSeen + other.theNumSeen };
+				for (FitNdxPair const & fitNdx : other.theBests)
+				{
+					consider(fitNdx);
+				}
+				theWorst = worst;
+				theNumSeen = numSeen;
+			}
+			theIsWorstBound = (theIsWorstBound || other.theIsWorstBound);
+		}
+
+		//! Retained values in sorted order (best first)
+		inline
+		std::vector<FitNdxPair> const &
+		bests
+			() const
+		{
+			return theBests;
+		}
+
+		//! Largest value (only meaningful if 0 < theNumSeen)
+		inline
+		FitNdxPair const &
+		worst
+			() const
+		{
+			return theWorst;
+		}
+
+	}; // FitNdxSelector
+
+	//! Selection (best numBest and worst) from all of the fitNdxPairs.
+	inline
+	FitNdxSelector
+	fitSelectionFrom
+		( std::vector<FitNdxPair> const & fitNdxPairs
+		, std::size_t const & numBest = 2u
+		)
+	{
+		FitNdxSelector selector{ FitNdxSelector::withNumBest(numBest) };
+		for (FitNdxPair const & fitNdxPair : fitNdxPairs)
+		{
+			selector.consider(fitNdxPair);
+		}
+		return selector;
+	}
+
+	/*! \brief Convention error values and associated convention index.
+	 *
+	 * Uses every element of allBoxConventions to transform each of the
+	 * two ParmGroup values (both transformed with same convention). For
+	 * each resulting pair of orientations (in black box frame) a relative
+	 * orientation, roBox, is computed and compared with the provided
+	 * independent relative orientation transform, relOri.
+	 *
+	 * For each convention case, the error between the roBox and roInd
+	 * transformations is computed. This fitError value is stored in the
+	 * first member of the returned pairs, and the index (of allBoxConventions)
+	 * used for the computation is stored in the second member of the pair.
+	 * 
+	 * Note that the second member of the pair is the same as offset
+	 * into the array. This is done to faciliate subsequent sorting
+	 * (e.g. simply sort the return array, in order to obtain the best
+	 * fit values via:
+	 * \arg (returnCollection)[0].first -- is the smallest fit error found
+	 * \arg (returnCollection)[0].second -- is the index, ndx, to the member
+	 * of allBoxConventions[ndx] that was used to obtain the fit error.
+	 */
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsFor
+		( std::map<SenKey, ParmGroup> const & keyGroups
+		, std::map<KeyPair, SenOri> const & keyIndRelOris
+		, std::vector<Convention> const & allBoxConventions
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		// accumulated fit errors, sum for each convention in allBoxConventions
+		std::vector<double> const sumFitErrors
+			{ fitErrorByConvention
+				(keyGroups, keyIndRelOris, allBoxConventions, numThreads)
+			};
+		return fitIndexPairsFrom(sumFitErrors, keyIndRelOris.size());
+	}
+
+	/*! \brief Convention error values and associated convention index.
+	 *
+	 * The keyIndEOs argument provide exterior orientation (EO) values
+	 * for each body of interest. These independent EO values are used
+	 * to compute relative orientations, RoInd, for each possible
+	 * (non-trivial) combination of the independent EOs.
+	 *
+	 * Each member of the allConventions collection, is utilized in
+	 * conjunction with the keyGroup instances (with the keyGroup's
+	 * SenKey matching the respective indKeyOri SenKey values). Together
+	 * the ParmGroup and Convention instances are used to create
+	 * candidate relative orientations in an assumed black box frame,
+	 * i.e. RoBox transform. A goodness of fit metric (Sum-squared-error)
+	 * is computed by comparing the RoInd and RoBox transformations.
+	 *
+	 * The fit error and the associated allConventions index (with
+	 * which that fit error is computed) are placed into the return
+	 * value collection.
+	 *
+	 * NOTE: There must be two or more individual EOs in order to
+	 *       compare candidate ROs. If not, the return collection
+	 *       will be empty.
+	 *
+	 * Example
+	 * \snippet test_Analysis.cpp DoxyExample01
+	 */
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsFor
+		( std::map<SenKey, ParmGroup> const & keyGroups
+		, std::map<SenKey, SenOri> const & keyIndEOs
+		, std::vector<Convention> const & allBoxConventions
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		std::vector<FitNdxPair> fitNdxPairs;
+
+		if (1u < keyIndEOs.size())
+		{
+			// generate ROs from indepent exterior body orientations
+			std::map<KeyPair, SenOri> const keyIndRelOris
+				{ relativeOrientationBetweens(keyIndEOs) };
+
+			// core algorithm operating on the relative orientations
+			fitNdxPairs = fitIndexPairsFor
+				(keyGroups, keyIndRelOris, allBoxConventions, numThreads);
+		}
+
+		return fitNdxPairs;
+	}
+
+	/*! \brief Convention error values using precomputed Box ROs.
+	 *
+	 * Same as fitIndexPairsFor(keyGroups, keyIndEOs, allBoxConventions)
+	 * with boxTable from BoxRelOriTable::from(keyGroups, allBoxConventions)
+	 * (e.g. construct boxTable once and use it for many keyIndEOs).
+	 */
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsFor
+		( BoxRelOriTable const & boxTable
+		, std::map<SenKey, SenOri> const & keyIndEOs
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		std::vector<FitNdxPair> fitNdxPairs;
+
+		if (1u < keyIndEOs.size())
+		{
+			// generate ROs from indepent exterior body orientations
+			std::map<KeyPair, SenOri> const keyIndRelOris
+				{ relativeOrientationBetweens(keyIndEOs) };
+
+			// compare with precomputed Box ROs
+			std::vector<double> const sumFitErrors
+				{ fitErrorByConvention(boxTable, keyIndRelOris, numThreads) };
+			fitNdxPairs = fitIndexPairsFrom
+				(sumFitErrors, keyIndRelOris.size());
+		}
+
+		return fitNdxPairs;
+	}
+
+	//! ROs between all pairs of valid indTables using indConvention.
+	inline
+	std::vector<NdxRelOri>
+	indRelOrisFor
+		( std::vector<AttitudeTable> const & indTables
+		, Convention const & indConvention
+		)
+	{
+		// generate Ind exterior orientations
+		std::vector<SenOri> indOris;
+		{
+			prof::StageTimer const timer(prof::Stage::IndEOs);
+			indOris = orisFor(indTables, indConvention);
+		}
+
+		// ROs between all pairs of (valid) sensors
+		prof::StageTimer const timer(prof::Stage::RelOris);
+		std::vector<SenNdx> senNdxs;
+		senNdxs.reserve(indTables.size());
+		for (SenNdx ndx{0u} ; ndx < indTables.size() ; ++ndx)
+		{
+			if (indTables[ndx].isValid())
+			{
+				senNdxs.emplace_back(ndx);
+			}
+		}
+		return relativeOrientationBetweens(indOris, senNdxs);
+	}
+
+	/*! \brief Fit errors for Ind orientations given in SenNdx order.
+	 *
+	 * The indTables are arranged in SenNdx order of boxTable.theRegistry
+	 * (e.g. from attitudeTablesFor(boxTable.theRegistry, keyIndPGs)).
+	 * Ind orientations are generated from these using indConvention.
+	 * The result is the same as fitIndexPairsFor(boxTable, keyIndEOs)
+	 * with keyIndEOs from keyOrisFor(keyIndTables, indConvention)
+	 * provided that the registry includes all of the Ind keys.
+	 */
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsFor
+		( BoxRelOriTable const & boxTable
+		, std::vector<AttitudeTable> const & indTables
+		, Convention const & indConvention
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		std::vector<FitNdxPair> fitNdxPairs;
+
+		std::vector<NdxRelOri> const indROs
+			{ indRelOrisFor(indTables, indConvention) };
+
+		if (! indROs.empty())
+		{
+			// compare with precomputed Box ROs
+			std::vector<double> const sumFitErrors
+				{ fitErrorByConvention(boxTable, indROs, numThreads) };
+			fitNdxPairs = fitIndexPairsFrom(sumFitErrors, indROs.size());
+		}
+
+		return fitNdxPairs;
+	}
+
+	/*! \brief Best (and worst) fit errors for Ind orientations in SenNdx order.
+	 *
+	 * Same values as fitSelectionFrom(fitIndexPairsFor(boxTable,
+	 * indTables, indConvention, numThreads), numBest) but the (55296)
+	 * individual FitNdxPair values are never collected. Each thread
+	 * feeds a block of normalized fit errors (for every convention) into
+	 * its own FitNdxSelector and these are then merged (without locks).
+	 */
+	inline
+	FitNdxSelector
+	fitSelectionFor
+		( BoxRelOriTable const & boxTable
+		, std::vector<AttitudeTable> const & indTables
+		, Convention const & indConvention
+		, std::size_t const & numBest = 2u
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		FitNdxSelector selector{ FitNdxSelector::withNumBest(numBest) };
+
+		std::vector<NdxRelOri> const indROs
+			{ indRelOrisFor(indTables, indConvention) };
+
+		if (! indROs.empty())
+		{
+			// sums for each class of (identical) Box conventions
+			std::vector<double> const sumClassErrors
+				{ fitErrorByClass(boxTable, indROs, numThreads) };
+
+			// feed normalized errors for each convention to block selectors
+			prof::StageTimer const timer(prof::Stage::Select);
+			double const scale{ 1./static_cast<double>(indROs.size()) };
+			std::vector<std::size_t> const & classNdxs
+				= boxTable.theClasses.theClassNdxs;
+			std::size_t const numCons{ classNdxs.size() };
+			std::size_t const numBlocks
+				{ std::max(std::size_t{ 1u }, std::min(numThreads, numCons)) };
+			std::vector<FitNdxSelector> blockSelectors
+				(numBlocks, FitNdxSelector::withNumBest(numBest));
+			auto const selectBlock
+				{ [&blockSelectors, &sumClassErrors, &classNdxs
+				  , &scale, &numCons, &numBlocks]
+					( std::size_t const blockNdx
+					)
+				{
+					FitNdxSelector & blockSelector = blockSelectors[blockNdx];
+					std::size_t const cBeg{ (blockNdx * numCons) / numBlocks };
+					std::size_t const cEnd
+						{ ((blockNdx + 1u) * numCons) / numBlocks };
+					for (std::size_t cNdx{cBeg} ; cNdx < cEnd ; ++cNdx)
+					{
+						double const fitError
+							{ scale * sumClassErrors[classNdxs[cNdx]] };
+						blockSelector.consider(std::make_pair(fitError, cNdx));
+					}
+				}
+				};
+			par::forEachIndex(numBlocks, numThreads, selectBlock);
+
+			for (FitNdxSelector const & blockSelector : blockSelectors)
+			{
+				selector.merge(blockSelector);
+			}
+		}
+
+		return selector;
+	}
+
+	/*! \brief Best fit errors (as fitSelectionFor()) via branch-and-bound.
+	 *
+	 * Each class of Box conventions is evaluated one RO pair at a time.
+	 * A class is abandoned as soon as its running (normalized) sum
+	 * exceeds the current numBest-th best value, since the remaining
+	 * (non-negative) pair errors can only increase it further. Pairs
+	 * are evaluated in order of decreasing (average) error over a
+	 * sample of classes so that the most discriminating pairs come
+	 * first. The sample results also provide the initial bound.
+	 *
+	 * Classes that are not abandoned are summed in the same (canonical)
+	 * pair order as fitErrorByClass() so that the bests() values are
+	 * exactly those from exhaustive search. However, theWorst is only
+	 * a lower bound on the largest fit error (if any class has been
+	 * abandoned, as indicated by theIsWorstBound).
+	 *
+	 * Blocks of classes are evaluated concurrently, each with its own
+	 * FitNdxSelector (and bound). These are merged at the end.
+	 */
+	inline
+	FitNdxSelector
+	fitSelectionPrunedFor
+		( BoxRelOriTable const & boxTable
+		, std::vector<AttitudeTable> const & indTables
+		, Convention const & indConvention
+		, std::size_t const & numBest = 2u
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		FitNdxSelector selector{ FitNdxSelector::withNumBest(numBest) };
+
+		std::vector<NdxRelOri> const indROs
+			{ indRelOrisFor(indTables, indConvention) };
+
+		// gather Box RO collections associated with each relative orientation
+		using BoxesRO = std::pair<OriBatch const *, SenOri const *>;
+		std::vector<BoxesRO> boxesROs;
+		boxesROs.reserve(indROs.size());
+		for (NdxRelOri const & indRO : indROs)
+		{
+			OriBatch const * const ptBoxROs
+				{ boxTable.boxROsFor(indRO.theNdx1, indRO.theNdx2) };
+			if (ptBoxROs)
+			{
+				boxesROs.emplace_back(ptBoxROs, &(indRO.theRelOri));
+			}
+		}
+
+		if (! indROs.empty())
+		{
+			double const scale{ 1./static_cast<double>(indROs.size()) };
+			std::size_t const numPairs{ boxesROs.size() };
+			std::size_t const numClasses{ boxTable.theClasses.numClasses() };
+			std::vector<std::vector<std::size_t> > const classMembers
+				{ boxTable.theClasses.membersByClass() };
+
+			// (full) evaluation of a sample of classes
+			constexpr std::size_t sNumSample{ 64u };
+			std::size_t const sampleStep
+				{ std::max(std::size_t{ 1u }, numClasses / sNumSample) };
+			std::vector<double> pairErrorSums(numPairs, 0.);
+			FitNdxSelector sampleSelector
+				{ FitNdxSelector::withNumBest(numBest) };
+			for (std::size_t kNdx{0u} ; kNdx < numClasses ; kNdx += sampleStep)
+			{
+				double sum{ 0. };
+				for (std::size_t pNdx{0u} ; pNdx < numPairs ; ++pNdx)
+				{
+					double const fitError
+						{ FitMetric::rmseBetween
+							( *(boxesROs[pNdx].first)
+							, kNdx
+							, *(boxesROs[pNdx].second)
+							)
+						};
+					pairErrorSums[pNdx] += fitError;
+					sum += fitError;
+				}
+				for (std::size_t const & memNdx : classMembers[kNdx])
+				{
+					sampleSelector.consider(std::make_pair(scale*sum, memNdx));
+				}
+			}
+
+			// most discriminating (largest typical error) pairs first
+			std::vector<std::size_t> evalOrder(numPairs);
+			for (std::size_t pNdx{0u} ; pNdx < numPairs ; ++pNdx)
+			{
+				evalOrder[pNdx] = pNdx;
+			}
+			std::stable_sort
+				( evalOrder.begin(), evalOrder.end()
+				, [&pairErrorSums]
+					( std::size_t const & pNdxA
+					, std::size_t const & pNdxB
+					)
+					{ return (pairErrorSums[pNdxB] < pairErrorSums[pNdxA]); }
+				);
+
+			// allow for differences in summation order (vs canonical)
+			constexpr double sRelTol{ 1.e-12 };
+			double const sampleBound{ sampleSelector.bound() };
+
+			// evaluate blocks of classes, abandoning hopeless ones
+			std::size_t const numBlocks
+				{ std::max
+					(std::size_t{ 1u }, std::min(numThreads, numClasses))
+				};
+			std::vector<FitNdxSelector> blockSelectors
+				(numBlocks, FitNdxSelector::withNumBest(numBest));
+			auto const evalBlock
+				{ [&blockSelectors, &boxesROs, &classMembers, &evalOrder
+				  , &scale, &sampleBound, &numPairs, &numClasses, &numBlocks]
+					( std::size_t const blockNdx
+					)
+				{
+					FitNdxSelector & blockSelector = blockSelectors[blockNdx];
+					std::vector<double> pairErrors(numPairs, 0.);
+					std::size_t const kBeg
+						{ (blockNdx * numClasses) / numBlocks };
+					std::size_t const kEnd
+						{ ((blockNdx + 1u) * numClasses) / numBlocks };
+					for (std::size_t kNdx{kBeg} ; kNdx < kEnd ; ++kNdx)
+					{
+						double const bound
+							{ std::min(sampleBound, blockSelector.bound()) };
+						double const limit{ bound + sRelTol*bound };
+
+						// accumulate (in evalOrder) until hopeless
+						double partial{ 0. };
+						bool hopeless{ false };
+						std::size_t nn{ 0u };
+						while ((! hopeless) && (nn < numPairs))
+						{
+							std::size_t const & pNdx = evalOrder[nn++];
+							pairErrors[pNdx] = FitMetric::rmseBetween
+								( *(boxesROs[pNdx].first)
+								, kNdx
+								, *(boxesROs[pNdx].second)
+								);
+							partial += pairErrors[pNdx];
+							hopeless = (limit < (scale * partial));
+						}
+
+						std::vector<std::size_t> const & members
+							= classMembers[kNdx];
+						if (hopeless)
+						{
+							for (std::size_t const & memNdx : members)
+							{
+								blockSelector.considerAtLeast
+									(std::make_pair(scale * partial, memNdx));
+							}
+						}
+						else
+						{
+							// sum in canonical order (as exhaustive search)
+							double sum{ 0. };
+							for (double const & pairError : pairErrors)
+							{
+								sum += pairError;
+							}
+							for (std::size_t const & memNdx : members)
+							{
+								blockSelector.consider
+									(std::make_pair(scale * sum, memNdx));
+							}
+						}
+					}
+				}
+				};
+			par::forEachIndex(numBlocks, numThreads, evalBlock);
+
+			for (FitNdxSelector const & blockSelector : blockSelectors)
+			{
+				selector.merge(blockSelector);
+			}
+		}
+
+		return selector;
+	}
+
+	/*! \brief Spatial index (for each sensor pair) of Box RO classes.
+	 *
+	 * Each Box RO (one per class of conventions) is represented by a
+	 * point in 7D: the spinor components (with non-negative scalar)
+	 * and the location. For any two ROs with (closed form) fit error,
+	 * rmse (ref rmseRotorBetween()), the distance between these points
+	 * (for one of the two spinor signs) satisfies:
+	 * \verbatim
+	 *   dist^2 <= 7.5 * rmse^2
+	 * \endverbatim
+	 * (I.e. for relative rotor (c,b) and location t, the rmse^2 is at
+	 * least (4/3)|b|^2 and (1/2)|t|^2 - (8/3)|b|^2, while the spinor
+	 * chord (squared) is no more than 2|b|^2.) Therefore all classes
+	 * with a fit error within maxPairError of an (Ind) RO are found by
+	 * a radius query of (sqrt(7.5)*maxPairError) for each spinor sign.
 	 */
-	inline
-	SenOri
-	relativeOrientationFor
-		( ParmGroup const & pg1
-		, ParmGroup const & pg2
-		, Convention const & convention
-		)
+	struct BoxRelOriIndex
 	{
-		// generate forward transforms internal to black box frame
-		SenOri const ori1wB{ convention.transformFor(pg1) };
-		SenOri const ori2wB{ convention.transformFor(pg2) };
-		// compute relative orientation in black box frame
-		SenOri const oriBw1{ inverse(ori1wB) };
-		SenOri const roBox{ ori2wB * oriBw1 };
-		return roBox;
-	}
+		//! Point representation of an RO.
+		using Point = KdTree<7u>::Point;
 
-	/*! \brief Sum-squared-errors (SSE) (across all ROs) by each convention.
+		//! Ratio of point distance to (maximum) rmse fit error.
+		static constexpr double sRadiusPerError{ 2.7386127875258306 };
+
+		//! Trees (for each class) at [ndx1*N+ndx2] as for BoxRelOriTable.
+		std::vector<KdTree<7u> > thePairTrees{};
+
+		//! Point coordinates for parts (with spinor sign as given).
+		inline
+		static
+		Point
+		pointFor
+			( OriParts const & parts
+			, double const & spinSign = 1.
+			)
+		{
+			return Point
+				{ spinSign * parts.theSca
+				, spinSign * parts.theBiv[0]
+				, spinSign * parts.theBiv[1]
+				, spinSign * parts.theBiv[2]
+				, parts.theLoc[0]
+				, parts.theLoc[1]
+				, parts.theLoc[2]
+				};
+		}
+
+		//! Point coordinates for parts with (canonical) non-negative scalar.
+		inline
+		static
+		Point
+		canonicalPointFor
+			( OriParts const & parts
+			)
+		{
+			double const spinSign{ (parts.theSca < 0.) ? -1. : 1. };
+			return pointFor(parts, spinSign);
+		}
+
+		//! Index for every (tabulated) sensor pair of boxTable.
+		inline
+		static
+		BoxRelOriIndex
+		from
+			( BoxRelOriTable const & boxTable
+			)
+		{
+			BoxRelOriIndex index;
+			index.thePairTrees.resize(boxTable.thePairBoxROs.size());
+			std::size_t const numPairs{ index.thePairTrees.size() };
+			for (std::size_t pNdx{0u} ; pNdx < numPairs ; ++pNdx)
+			{
+				OriBatch const & roBoxes = boxTable.thePairBoxROs[pNdx];
+				std::vector<Point> points;
+				points.reserve(roBoxes.size());
+				for (std::size_t kNdx{0u} ; kNdx < roBoxes.size() ; ++kNdx)
+				{
+					points.emplace_back
+						(canonicalPointFor(roBoxes.partsAt(kNdx)));
+				}
+				index.thePairTrees[pNdx] = KdTree<7u>::from(points);
+			}
+			return index;
+		}
+
+		/*! \brief Classes (sorted) with Box RO that may be near indRO.
+		 *
+		 * The result includes every class for which the fit error of
+		 * the Box RO with indRO is not more than maxPairError (but
+		 * may include others as well).
+		 */
+		inline
+		std::vector<std::size_t>
+		classesNear
+			( std::size_t const & pairNdx
+			, OriParts const & indRO
+			, double const & maxPairError
+			) const
+		{
+			std::vector<std::size_t> classNdxs;
+			if (pairNdx < thePairTrees.size())
+			{
+				KdTree<7u> const & tree = thePairTrees[pairNdx];
+				// (slightly enlarged to allow for roundoff)
+				constexpr double sPad{ 1. + 1.e-9 };
+				double const radius{ sPad * sRadiusPerError * maxPairError };
+				tree.appendWithin(pointFor(indRO, 1.), radius, &classNdxs);
+				tree.appendWithin(pointFor(indRO, -1.), radius, &classNdxs);
+				std::sort(classNdxs.begin(), classNdxs.end());
+				classNdxs.erase
+					( std::unique(classNdxs.begin(), classNdxs.end())
+					, classNdxs.end()
+					);
+			}
+			return classNdxs;
+		}
+
+	}; // BoxRelOriIndex
+
+	//! Result of a (spatial index) search for conventions near Ind ROs.
+	struct NearSelection
+	{
+		//! Best (and worst) of the conventions found near all Ind ROs.
+		FitNdxSelector theSelector{};
+
+		//! All other conventions have fit error larger than this.
+		double theFitBound{ engabra::g3::null<double>() };
+
+		//! True if theSelector bests are those of exhaustive search.
+		inline
+		bool
+		isExact
+			() const
+		{
+			std::vector<FitNdxPair> const & bests = theSelector.bests();
+			return
+				(  (0u < bests.size())
+				&& (theSelector.theNumBest == bests.size())
+				&& (! (theFitBound < bests.back().first))
+				);
+		}
+
+	}; // NearSelection
+
+	/*! \brief Fit errors only for conventions near to all of the Ind ROs.
 	 *
-	 * For each Convention (from allCons), compute the root average
-	 * squared error (RASE) associated with each RO. Sum these per-RO
-	 * RASE values into the SSE values for that Convention.
+	 * For each Ind RO, boxIndex provides the classes of conventions
+	 * with (Box RO) fit error that may be within maxPairError. Only
+	 * classes in the intersection of these candidate sets (over all
+	 * ROs) are scored (exactly as fitErrorByClass(), i.e. with the same
+	 * values as exhaustive search).
 	 *
-	 * The return collection contains SSE values in 1:1 correspondence
-	 * with the convention cases in allCons.
+	 * Conventions outside the intersection have some RO error larger
+	 * than maxPairError and therefore a fit error (normalized sum)
+	 * larger than maxPairError/numROs (NearSelection::theFitBound).
+	 * If the numBest-th selected value is not larger than this bound,
+	 * NearSelection::isExact() is true. Otherwise (e.g. if there are
+	 * no candidates) a full evaluation is needed for an exact result.
+	 *
+	 * The selector worst value is only that of the candidates, i.e.
+	 * it is a lower bound (theIsWorstBound) unless every class is a
+	 * candidate.
 	 */
 	inline
-	std::vector<double>
-	fitErrorByConvention
-		( std::map<SenKey, ParmGroup> const & keyGroups
-		, std::map<KeyPair, SenOri> const & relKeyOris
-		, std::vector<Convention> const & allCons
+	NearSelection
+	fitSelectionNearFor
+		( BoxRelOriTable const & boxTable
+		, BoxRelOriIndex const & boxIndex
+		, std::vector<AttitudeTable> const & indTables
+		, Convention const & indConvention
+		, double const & maxPairError
+		, std::size_t const & numBest = 2u
 		)
 	{
-		// accumulation of fit errors, one for each convention in allCons
-		std::vector<double> sumFitErrors(allCons.size(), 0.);
+		NearSelection nearSel;
+		nearSel.theSelector = FitNdxSelector::withNumBest(numBest);
+
+		std::vector<NdxRelOri> const indROs
+			{ indRelOrisFor(indTables, indConvention) };
 
-		// compute consistency score vector for each relative orientation
-		for (std::map<KeyPair, SenOri>::value_type
-			const & relKeyOri : relKeyOris)
+		if (! indROs.empty())
 		{
-			// access data for this RO
-			KeyPair const & keyPair = relKeyOri.first;
-			SenOri const & relOri = relKeyOri.second;
+			double const scale{ 1./static_cast<double>(indROs.size()) };
+			nearSel.theFitBound = scale * maxPairError;
 
-			// locate parameter groups for the two RO keys
-			std::map<SenKey, ParmGroup>::const_iterator
-				const itFind1{ keyGroups.find(keyPair.key1()) };
-			std::map<SenKey, ParmGroup>::const_iterator
-				const itFind2{ keyGroups.find(keyPair.key2()) };
-			if ( (keyGroups.end() != itFind1)
-			  && (keyGroups.end() != itFind1)
-			   )
+			// intersection of candidate classes over all (tabulated) pairs
+			std::size_t const numSen{ boxTable.theRegistry.size() };
+			using BoxesRO = std::pair<OriBatch const *, SenOri const *>;
+			std::vector<BoxesRO> boxesROs;
+			std::vector<std::size_t> candNdxs;
+			bool isFirst{ true };
+			for (NdxRelOri const & indRO : indROs)
 			{
-				ParmGroup const & pg1 = itFind1->second;
-				ParmGroup const & pg2 = itFind2->second;
+				OriBatch const * const ptBoxROs
+					{ boxTable.boxROsFor(indRO.theNdx1, indRO.theNdx2) };
+				if (ptBoxROs)
+				{
+					boxesROs.emplace_back(ptBoxROs, &(indRO.theRelOri));
+					std::vector<std::size_t> const nearNdxs
+						{ boxIndex.classesNear
+							( indRO.theNdx1*numSen + indRO.theNdx2
+							, OriParts::from(indRO.theRelOri)
+							, maxPairError
+							)
+						};
+					if (isFirst)
+					{
+						candNdxs = nearNdxs;
+						isFirst = false;
+					}
+					else
+					{
+						std::vector<std::size_t> bothNdxs;
+						std::set_intersection
+							( candNdxs.cbegin(), candNdxs.cend()
+							, nearNdxs.cbegin(), nearNdxs.cend()
+							, std::back_inserter(bothNdxs)
+							);
+						candNdxs.swap(bothNdxs);
+					}
+				}
+			}
 
-				// compute fit scores for all conventions
-				for (std::size_t cNdx{0u} ; cNdx < allCons.size() ; ++cNdx)
+			// score candidates (in canonical order as fitErrorByClass())
+			std::vector<std::vector<std::size_t> > const classMembers
+				{ boxTable.theClasses.membersByClass() };
+			for (std::size_t const & kNdx : candNdxs)
+			{
+				double sum{ 0. };
+				for (BoxesRO const & boxesRO : boxesROs)
 				{
-					Convention const & convention = allCons[cNdx];
-					SenOri const roBox
-						{ relativeOrientationFor(pg1, pg2, convention) };
-					double const fitError
-						{ rmseBasisErrorBetween(roBox, relOri) };
-					sumFitErrors[cNdx] += fitError;
+					sum += FitMetric::rmseBetween
+						(*(boxesRO.first), kNdx, *(boxesRO.second));
+				}
+				for (std::size_t const & memNdx : classMembers[kNdx])
+				{
+					nearSel.theSelector.consider
+						(std::make_pair(scale * sum, memNdx));
 				}
 			}
+			nearSel.theSelector.theIsWorstBound
+				= (candNdxs.size() < boxTable.theClasses.numClasses());
 		}
 
-		return sumFitErrors;
+		return nearSel;
 	}
 
-
-	//! Pair of (fitErrorValue, ConventionArrayIndex))
-	using FitNdxPair = std::pair<double, std::size_t>;
-
-	/*! \brief Convention error values and associated convention index.
+	/*! \brief Fit errors from a two-stage (rotation first) search.
 	 *
-	 * Uses every element of allBoxConventions to transform each of the
-	 * two ParmGroup values (both transformed with same convention). For
-	 * each resulting pair of orientations (in black box frame) a relative
-	 * orientation, roBox, is computed and compared with the provided
-	 * independent relative orientation transform, relOri.
+	 * The attitude of each Box RO depends only on the ConventionAngle
+	 * part of a Convention. The offset convention and OrderTR affect
+	 * only the translation. The search is therefore performed in two
+	 * stages:
 	 *
-	 * For each convention case, the error between the roBox and roInd
-	 * transformations is computed. This fitError value is stored in the
-	 * first member of the returned pairs, and the index (of allBoxConventions)
-	 * used for the computation is stored in the second member of the pair.
-	 * 
-	 * Note that the second member of the pair is the same as offset
-	 * into the array. This is done to faciliate subsequent sorting
-	 * (e.g. simply sort the return array, in order to obtain the best
-	 * fit values via:
-	 * \arg (returnCollection)[0].first -- is the smallest fit error found
-	 * \arg (returnCollection)[0].second -- is the index, ndx, to the member
-	 * of allBoxConventions[ndx] that was used to obtain the fit error.
+	 * \arg Each of the (576) angle conventions is scored by the sum
+	 * (over all keyIndRelOris) of rotation-only fit errors, i.e.
+	 * rmseRotationErrorBetween().
+	 *
+	 * \arg The numAngleCandidates best scoring angle conventions are
+	 * then each expanded over all (48) offset conventions and both
+	 * OrderTR values. Each of these is scored with the full fit error
+	 * (i.e. as in fitIndexPairsFor()).
+	 *
+	 * This requires about (576 + 96*numAngleCandidates) evaluations
+	 * per RO instead of 55296. The result is the same as brute force
+	 * search provided that the rotation residuals place the correct
+	 * angle convention among the numAngleCandidates best.
+	 *
+	 * The returned pairs are (normalized fit error, index) values for
+	 * each evaluated convention. Note that the index refers to the
+	 * position in Convention::allConventions() (not to some other
+	 * collection). Conventions that are not evaluated are not included
+	 * in the return collection (e.g. the worst error is the worst among
+	 * the evaluated candidates only).
+	 *
+	 * The keyTables (e.g. from attitudeTablesFor(keyBoxPGs)) are the
+	 * same for all Ind trials and should be generated only once.
 	 */
 	inline
 	std::vector<FitNdxPair>
-	fitIndexPairsFor
-		( std::map<SenKey, ParmGroup> const & keyGroups
+	fitIndexPairsRotationFirst
+		( std::map<SenKey, AttitudeTable> const & keyTables
 		, std::map<KeyPair, SenOri> const & keyIndRelOris
-		, std::vector<Convention> const & allBoxConventions
+		, std::size_t const & numAngleCandidates
 		)
 	{
-		std::vector<FitNdxPair> allFitConPairs;
-
-		// accumulated fit errors, sum for each convention in allBoxConventions
-		std::vector<double> const sumFitErrors
-			{ fitErrorByConvention
-				(keyGroups, keyIndRelOris, allBoxConventions)
-			};
+		std::vector<FitNdxPair> fitNdxPairs;
 
-		// normalize the scores by number of ROs
-		std::size_t const numRelOris{ keyIndRelOris.size() };
-		double const scale{ 1./static_cast<double>(numRelOris) };
+		// sensor indices for each relative orientation (both keys present)
+		std::vector<NdxRelOri> const nnROs
+			{ ndxRelOrisFor(keyTables, keyIndRelOris) };
+		SensorTransforms xfms{ SensorTransforms::from(keyTables) };
 
-		// associate the errors with allBoxConventions collection index
-		std::size_t const numFit{ sumFitErrors.size() };
-		allFitConPairs.reserve(numFit);
-		for (std::size_t nn{0u} ; nn < numFit ; ++nn)
+		if (! nnROs.empty())
 		{
-			allFitConPairs.emplace_back
-				(std::make_pair(scale*sumFitErrors[nn], nn));
+			// Stage 1: score each angle convention by rotation residuals
+			// (any offset and order convention provides same rotation)
+			std::vector<ConventionAngle> const angConvs
+				{ ConventionAngle::allConventions() };
+			std::vector<FitNdxPair> angFitNdxs;
+			angFitNdxs.reserve(angConvs.size());
+			for (std::size_t aNdx{0u} ; aNdx < angConvs.size() ; ++aNdx)
+			{
+				Convention const rotCon
+					{ ConventionOffset{ { 1, 1, 1 }, { 0u, 1u, 2u } }
+					, angConvs[aNdx]
+					, TranRot
+					};
+				xfms.setConvention(rotCon);
+				double sumRotError{ 0. };
+				for (NdxRelOri const & nnRO : nnROs)
+				{
+					SenOri const roBox
+						{ xfms.relativeOrientation
+							(nnRO.theNdx1, nnRO.theNdx2)
+						};
+					sumRotError += rmseRotationErrorBetween
+						(roBox, nnRO.theRelOri);
+				}
+				angFitNdxs.emplace_back(std::make_pair(sumRotError, aNdx));
+			}
+
+			// retain the best scoring angle conventions
+			std::size_t const numKeep
+				{ std::min(numAngleCandidates, angFitNdxs.size()) };
+			std::partial_sort
+				( angFitNdxs.begin()
+				, angFitNdxs.begin() + numKeep
+				, angFitNdxs.end()
+				);
+
+			// Stage 2: expand candidates over all offsets and orders
+			std::vector<ConventionOffset> const offConvs
+				{ ConventionOffset::allConventions() };
+			std::array<OrderTR, 2u> const orders{ allOrderTRs() };
+			std::size_t const numRelOris{ keyIndRelOris.size() };
+			double const scale{ 1./static_cast<double>(numRelOris) };
+			fitNdxPairs.reserve(numKeep * offConvs.size() * orders.size());
+			for (std::size_t nKeep{0u} ; nKeep < numKeep ; ++nKeep)
+			{
+				std::size_t const & aNdx = angFitNdxs[nKeep].second;
+				for (std::size_t oNdx{0u} ; oNdx < offConvs.size() ; ++oNdx)
+				{
+					for (OrderTR const & order : orders)
+					{
+						Convention const convention
+							{ offConvs[oNdx], angConvs[aNdx], order };
+						xfms.setConvention(convention);
+						double sumFitError{ 0. };
+						for (NdxRelOri const & nnRO : nnROs)
+						{
+							SenOri const roBox
+								{ xfms.relativeOrientation
+									(nnRO.theNdx1, nnRO.theNdx2)
+								};
+							sumFitError += FitMetric::rmseBetween
+								(roBox, nnRO.theRelOri);
+						}
+						std::size_t const cNdx
+							{ Convention::indexValueFor(oNdx, aNdx, order) };
+						fitNdxPairs.emplace_back
+							(std::make_pair(scale*sumFitError, cNdx));
+					}
+				}
+			}
 		}
 
-		return allFitConPairs;
+		return fitNdxPairs;
 	}
 
-	/*! \brief Convention error values and associated convention index.
-	 *
-	 * The keyIndEOs argument provide exterior orientation (EO) values
-	 * for each body of interest. These independent EO values are used
-	 * to compute relative orientations, RoInd, for each possible
-	 * (non-trivial) combination of the independent EOs.
-	 *
-	 * Each member of the allConventions collection, is utilized in
-	 * conjunction with the keyGroup instances (with the keyGroup's
-	 * SenKey matching the respective indKeyOri SenKey values). Together
-	 * the ParmGroup and Convention instances are used to create
-	 * candidate relative orientations in an assumed black box frame,
-	 * i.e. RoBox transform. A goodness of fit metric (Sum-squared-error)
-	 * is computed by comparing the RoInd and RoBox transformations.
-	 *
-	 * The fit error and the associated allConventions index (with
-	 * which that fit error is computed) are placed into the return
-	 * value collection.
-	 *
-	 * NOTE: There must be two or more individual EOs in order to
-	 *       compare candidate ROs. If not, the return collection
-	 *       will be empty.
-	 *
-	 * Example
-	 * \snippet test_Analysis.cpp DoxyExample01
-	 */
+	//! Two-stage search (as above) with attitudes from keyGroups.
 	inline
 	std::vector<FitNdxPair>
-	fitIndexPairsFor
+	fitIndexPairsRotationFirst
 		( std::map<SenKey, ParmGroup> const & keyGroups
+		, std::map<KeyPair, SenOri> const & keyIndRelOris
+		, std::size_t const & numAngleCandidates
+		)
+	{
+		return fitIndexPairsRotationFirst
+			(attitudeTablesFor(keyGroups), keyIndRelOris, numAngleCandidates);
+	}
+
+	//! Two-stage search (as above) with ROs formed from keyIndEOs.
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsRotationFirst
+		( std::map<SenKey, AttitudeTable> const & keyTables
 		, std::map<SenKey, SenOri> const & keyIndEOs
-		, std::vector<Convention> const & allBoxConventions
+		, std::size_t const & numAngleCandidates
 		)
 	{
 		std::vector<FitNdxPair> fitNdxPairs;
-
 		if (1u < keyIndEOs.size())
 		{
 			// generate ROs from indepent exterior body orientations
 			std::map<KeyPair, SenOri> const keyIndRelOris
 				{ relativeOrientationBetweens(keyIndEOs) };
-
-			// core algorithm operating on the relative orientations
-			fitNdxPairs = fitIndexPairsFor
-				(keyGroups, keyIndRelOris, allBoxConventions);
+			fitNdxPairs = fitIndexPairsRotationFirst
+				(keyTables, keyIndRelOris, numAngleCandidates);
 		}
-
 		return fitNdxPairs;
 	}
 
-	//! Residual error for orientations with the two string encodings.
+	//! Two-stage search (as above) with attitudes from keyGroups.
+	inline
+	std::vector<FitNdxPair>
+	fitIndexPairsRotationFirst
+		( std::map<SenKey, ParmGroup> const & keyGroups
+		, std::map<SenKey, SenOri> const & keyIndEOs
+		, std::size_t const & numAngleCandidates
+		)
+	{
+		return fitIndexPairsRotationFirst
+			(attitudeTablesFor(keyGroups), keyIndEOs, numAngleCandidates);
+	}
+
+	/*! \brief Selection (as fitSelectionFrom()) from two-stage search.
+	 *
+	 * The bests are those of fitIndexPairsRotationFirst(). Unless every
+	 * convention has been evaluated, the worst value is only that of
+	 * the candidates and is therefore flagged (theIsWorstBound) as a
+	 * lower bound on the worst fit error.
+	 */
+	inline
+	FitNdxSelector
+	fitSelectionRotationFirst
+		( std::map<SenKey, AttitudeTable> const & keyTables
+		, std::map<SenKey, SenOri> const & keyIndEOs
+		, std::size_t const & numAngleCandidates
+		, std::size_t const & numBest = 2u
+		)
+	{
+		std::vector<FitNdxPair> const fitNdxPairs
+			{ fitIndexPairsRotationFirst
+				(keyTables, keyIndEOs, numAngleCandidates)
+			};
+		FitNdxSelector selector{ fitSelectionFrom(fitNdxPairs, numBest) };
+		selector.theIsWorstBound
+			= (fitNdxPairs.size() < Convention::theNumConventions);
+		return selector;
+	}
+
+	//! Residual error for orientations with the two conventions.
 	struct OneSolutionFit
 	{
 		//! Fit error for a particular solution
 		double theFitError{ engabra::g3::null<double>() };
 
-		//! Encoding for Convention used for box orientation.
-		std::string theBoxCS{};
+		//! Convention used for box orientation.
+		ConventionId theBoxConvId{ sNullConventionId };
 
-		//! Encoding for Convention used for independent Ind orientation.
-		std::string theIndCS{};
+		//! Convention used for independent Ind orientation.
+		ConventionId theIndConvId{ sNullConventionId };
 
 		/*! Instance from lookup/combination of arguments.
 		 *
 		 * The index (.second) from fitNdxPair is used to obtain
-		 * Convention from the allBoxCon's array. This convention
-		 * and the explicit currIndConv convention are encoded
-		 * as strings. The fit error (fitNdxPair.first), and the
-		 * two encoded strings are then used to instantiate the
-		 * returned instance.
+		 * Convention from the allBoxCon's array. The (compact)
+		 * identifiers of this convention and of the explicit
+		 * currIndConv convention are stored along with the fit
+		 * error (fitNdxPair.first). Text encodings are only formed
+		 * when requested (e.g. when results are reported).
 		 */
 		static
 		OneSolutionFit
@@ -316,20 +2122,30 @@ namespace om
 			)
 		{
 			double const & fitError = fitNdxPair.first;
-
-			// fetch Box conventions string
 			std::size_t const & bestBoxNdx = fitNdxPair.second;
-			om::Convention const & bestBoxConv{ allBoxCons[bestBoxNdx] };
-			om::ConventionString const csBox
-				{ om::ConventionString::from(bestBoxConv) };
-			std::string const boxCS{ csBox.stringEncoding() };
+			return OneSolutionFit
+				{ fitError
+				, conventionIdFor(allBoxCons[bestBoxNdx])
+				, conventionIdFor(currIndConv)
+				};
+		}
 
-			// get Ind conventions string
-			om::ConventionString const csInd
-				{ om::ConventionString::from(currIndConv) };
-			std::string const indCS{ csInd.stringEncoding() };
+		//! Encoding for Convention used for box orientation.
+		inline
+		ConventionText
+		boxText
+			() const
+		{
+			return ConventionText::from(theBoxConvId);
+		}
 
-			return OneSolutionFit{ fitError, boxCS, indCS };
+		//! Encoding for Convention used for independent Ind orientation.
+		inline
+		ConventionText
+		indText
+			() const
+		{
+			return ConventionText::from(theIndConvId);
 		}
 
 	}; // OneSolutionFit
@@ -341,6 +2157,18 @@ namespace om
 		OneSolutionFit the2nd{};
 		OneSolutionFit theEnd{};
 
+		//! True if theEnd fit error is only a lower bound (e.g. pruned).
+		bool theIsEndBound{ false };
+
+		//! True if this instance contains (at least) a best solution.
+		inline
+		bool
+		isValid
+			() const
+		{
+			return engabra::g3::isValid(the1st.theFitError);
+		}
+
 		//! Prominence of result [from fit errors as (2nd-1st)/End]
 		inline
 		double
@@ -357,7 +2185,21 @@ namespace om
 			return prom;
 		}
 
-		//! Descriptive information about this instance
+		//! Difference between 2nd and 1st fit errors (exact even if pruned).
+		inline
+		double
+		fitGap
+			() const
+		{
+			return (the2nd.theFitError - the1st.theFitError);
+		}
+
+		/*! \brief Descriptive information about this instance
+		 *
+		 * If theEnd fit error is only a lower bound, the EndFit and
+		 * promFrac labels are shown as "EndFit>=" and "promFrac<="
+		 * (with the same widths as for exact values).
+		 */
 		inline
 		std::string
 		infoString
@@ -372,11 +2214,13 @@ namespace om
 			using engabra::g3::io::fixed;
 			oss
 				<< "fitError: " << fixed(the1st.theFitError, 8u, 6u)
-				<< "  boxPGs: " << the1st.theBoxCS
-				<< "  indPGs: " << the1st.theIndCS
+				<< "  boxPGs: " << the1st.boxText().view()
+				<< "  indPGs: " << the1st.indText().view()
 				<< "  2ndFit: " << fixed(the2nd.theFitError, 8u, 6u)
-				<< "  EndFit: " << fixed(theEnd.theFitError, 8u, 6u)
-				<< "  promFrac: " << fixed(prominence())
+				<< (theIsEndBound ? "  EndFit>=" : "  EndFit: ")
+				<< fixed(theEnd.theFitError, 8u, 6u)
+				<< (theIsEndBound ? "  promFrac<=" : "  promFrac: ")
+				<< fixed(prominence())
 				;
 			return oss.str();
 		}
@@ -384,45 +2228,50 @@ namespace om
 	}; // OneTrialResult
 
 
-	//! Result of one trial involving all boxPG conventions for one indEO set.
+	//! Result of one trial from the best and worst selected conventions.
 	inline
 	OneTrialResult
 	trialResultFrom
-		( std::vector<FitNdxPair> const & fitIndexPairs
+		( FitNdxSelector const & selector
 		, std::vector<Convention> const & allBoxCons
 		, Convention const & currIndCon
 		)
 	{
-		// sort from best and worst
-		// Note: could use min and max then find second min for efficiency
-		//       but overall, this probably isn't the slowest part
-		std::vector<FitNdxPair> fitNdxs{ fitIndexPairs }; // copy to sort
-		std::sort(fitNdxs.begin(), fitNdxs.end());
-
 		OneTrialResult trialResult;
-		std::size_t const numPairs{ fitNdxs.size() };
-		if (0u < numPairs)
+		std::vector<FitNdxPair> const & bests = selector.bests();
+		if (0u < bests.size())
 		{
-			FitNdxPair const & ndxPair1st = fitNdxs[0u];
 			trialResult.the1st = OneSolutionFit::from
-				(ndxPair1st, allBoxCons, currIndCon);
+				(bests[0u], allBoxCons, currIndCon);
 		}
-		if (1u < numPairs)
+		if (1u < bests.size())
 		{
-			FitNdxPair const & ndxPair2nd = fitNdxs[1u];
 			trialResult.the2nd = OneSolutionFit::from
-				(ndxPair2nd, allBoxCons, currIndCon);
+				(bests[1u], allBoxCons, currIndCon);
 		}
-		if (2u < numPairs)
+		if (2u < selector.theNumSeen)
 		{
-			FitNdxPair const & ndxPairEnd = fitNdxs[numPairs-1u];
 			trialResult.theEnd = OneSolutionFit::from
-				(ndxPairEnd, allBoxCons, currIndCon);
+				(selector.worst(), allBoxCons, currIndCon);
+			trialResult.theIsEndBound = selector.theIsWorstBound;
 		}
-
 		return trialResult;
 	}
 
+	//! Result of one trial involving all boxPG conventions for one indEO set.
+	inline
+	OneTrialResult
+	trialResultFrom
+		( std::vector<FitNdxPair> const & fitIndexPairs
+		, std::vector<Convention> const & allBoxCons
+		, Convention const & currIndCon
+		)
+	{
+		// only the best two and the worst are needed (no need to sort)
+		return trialResultFrom
+			(fitSelectionFrom(fitIndexPairs, 2u), allBoxCons, currIndCon);
+	}
+
 	//! Order such that small error and larger prominence are both less.
 	inline
 	bool
@@ -441,6 +2290,48 @@ namespace om
 		return (pairA < pairB);
 	}
 
+	/*! \brief Sort trialResults (best first) for reporting.
+	 *
+	 * If every result has an exact EndFit, the order is that of
+	 * operator<() (i.e. by prominence). Otherwise, the prominence of
+	 * some results is only an upper bound and all of them are ranked
+	 * by the (exact) fitGap() instead - such that the order does not
+	 * depend on which trials happened to be bounded.
+	 */
+	inline
+	void
+	sortForReport
+		( std::vector<OneTrialResult> * const & ptTrialResults
+		)
+	{
+		std::vector<OneTrialResult> & trialResults = *ptTrialResults;
+		bool const anyBound
+			{ std::any_of
+				( trialResults.cbegin(), trialResults.cend()
+				, [] (OneTrialResult const & trialResult)
+					{ return trialResult.theIsEndBound; }
+				)
+			};
+		if (anyBound)
+		{
+			std::sort
+				( trialResults.begin(), trialResults.end()
+				, [] (OneTrialResult const & trA, OneTrialResult const & trB)
+					{
+						std::pair<double, double> const pairA
+							{ trA.the1st.theFitError, -trA.fitGap() };
+						std::pair<double, double> const pairB
+							{ trB.the1st.theFitError, -trB.fitGap() };
+						return (pairA < pairB);
+					}
+				);
+		}
+		else
+		{
+			std::sort(trialResults.begin(), trialResults.end());
+		}
+	}
+
 
 } // [om]
 
@@ -0,0 +1,123 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef OriMania_BoxCache_INCL_
+#define OriMania_BoxCache_INCL_
+
+/*! \file
+\brief Persistent (file) cache of precomputed Box relative orientations.
+
+A BoxRelOriTable depends only on the Box ParmGroup values, the sensor
+registry and the conventions. It may therefore be saved once and then
+reloaded for any number of runs with different Ind data.
+
+The cache file is a flat binary image (native byte order) of the table
+arrays. It is read back via a memory mapping (where supported) with the
+arrays copied directly into the table, i.e. without any parsing. The
+file is only used if its key matches that from boxCacheKeyFor().
+
+Example:
+\snippet test_BoxCache.cpp DoxyExample01
+
+*/
+
+
+#include "Analysis.hpp"
+#include "Key.hpp"
+#include "ParmGroup.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+
+namespace om
+{
+	/*! \brief Hash value identifying content of a Box table.
+	 *
+	 * The value depends on the project version, on a version of the
+	 * table computation (RO arithmetic and class formation), the
+	 * registry keys (and their order), the Box ParmGroup values (bit
+	 * patterns) and on the number of conventions.
+	 */
+	std::uint64_t
+	boxCacheKeyFor
+		( SenRegistry const & registry
+		, std::map<SenKey, ParmGroup> const & keyBoxPGs
+		, std::size_t const & numConventions
+		);
+
+	/*! \brief Save boxTable (with cacheKey) to file at cachePath.
+	 *
+	 * The file is written under a unique temporary name (in the same
+	 * directory) and then renamed such that concurrent readers never
+	 * encounter a partial file and concurrent writers do not interfere.
+	 *
+	 * Returns true on success.
+	 */
+	bool
+	saveBoxTable
+		( std::string const & cachePath
+		, BoxRelOriTable const & boxTable
+		, std::uint64_t const & cacheKey
+		);
+
+	/*! \brief Box table loaded from file at cachePath.
+	 *
+	 * The table registry is set to the one provided (which is the one
+	 * that should have been used to generate cacheKey).
+	 *
+	 * If the file is missing, incomplete, has a key different from
+	 * cacheKey, or has class or representative indices that are out of
+	 * range (or inconsistent), the returned table is empty (i.e.
+	 * theNumConventions is zero).
+	 */
+	BoxRelOriTable
+	loadBoxTable
+		( std::string const & cachePath
+		, SenRegistry const & registry
+		, std::uint64_t const & cacheKey
+		);
+
+	/*! \brief Box table from the cache or (if missing) computed and saved.
+	 *
+	 * If the table is computed, an attempt is made to save it to the
+	 * cachePath (failure to do so is not an error). The (optional)
+	 * ptFromCache is set true if the table was loaded from the cache.
+	 */
+	BoxRelOriTable
+	cachedBoxTable
+		( std::string const & cachePath
+		, SenRegistry const & registry
+		, std::map<SenKey, ParmGroup> const & keyBoxPGs
+		, std::vector<Convention> const & allCons
+		, bool * const & ptFromCache = nullptr
+		);
+
+} // [om]
+
+
+#endif // OriMania_BoxCache_INCL_
@@ -44,6 +44,8 @@ Example:
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 
@@ -65,12 +67,20 @@ namespace om
 		//! \brief Permutations: 012, 021, 120, 102, 201, 210
 		ThreeIndices theOffIndices;
 
+		//! Number of unique conventions (size of allConventions())
+		static constexpr std::size_t theNumConventions{ 8u * 6u };
+
 		//! Collection of unique conventions that are supported overall
 		static
 		std::vector<ConventionOffset>
 		allConventions
 			();
 
+		//! Position of this instance within allConventions() [0,48)
+		std::size_t
+		indexValue
+			() const;
+
 	}; // ConventionOffset
 
 	/*! \brief Conventions for 3-angle sequences from 3 angle size values.
@@ -101,12 +111,20 @@ namespace om
 		 */
 		ThreeIndices theBivIndices;
 
+		//! Number of unique conventions (size of allConventions())
+		static constexpr std::size_t theNumConventions{ 8u * 6u * 12u };
+
 		//! Collection of unique conventions that are supported overall
 		static
 		std::vector<ConventionAngle>
 		allConventions
 			();
 
+		//! Position of this instance within allConventions() [0,576)
+		std::size_t
+		indexValue
+			() const;
+
 	}; // ConventionAngle
 
 	//! Candidate convention associated with 6 orientation values
@@ -121,6 +139,13 @@ namespace om
 		//! \brief Permutations: TranRot, RotTran
 		OrderTR theOrder{ Unknown };
 
+		//! Number of unique conventions (size of allConventions())
+		static constexpr std::size_t theNumConventions
+			{ ConventionOffset::theNumConventions
+			* ConventionAngle::theNumConventions
+			* 2u // OrderTR
+			};
+
 		//! Collection of unique conventions that are supported overall
 		static
 		std::vector<Convention>
@@ -134,6 +159,25 @@ namespace om
 		allConventions
 			();
 
+		/*! \brief Table of all conventions - same as allConventions().
+		 *
+		 * The table is generated at compile time (from conventionFor())
+		 * and is indexed by ConventionId (equivalently indexValue()).
+		 */
+		static
+		std::array<Convention, theNumConventions> const &
+		allConventionTable
+			();
+
+		//! Position within allConventions() of convention with these parts.
+		static
+		std::size_t
+		indexValueFor
+			( std::size_t const & offsetIndexValue
+			, std::size_t const & angleIndexValue
+			, OrderTR const & order
+			);
+
 		//! Construct an instance from numeric encoding.
 		static
 		Convention
@@ -146,6 +190,11 @@ namespace om
 		numberEncoding
 			() const;
 
+		//! Position of this instance within allConventions() [0,55296)
+		std::size_t
+		indexValue
+			() const;
+
 		//! True if this instance has valid data (uses theOrder as flag).
 		bool
 		isValid
@@ -163,6 +212,17 @@ namespace om
 			( ParmGroup const & parmGroup
 			) const;
 
+		/*! \brief Transform with ParmGroup values and precomputed attitude.
+		 *
+		 * The attR argument is expected to be the attitudeFor(parmGroup)
+		 * result (e.g. as looked up from an AttitudeTable).
+		 */
+		rigibra::Transform
+		transformFor
+			( ParmGroup const & parmGroup
+			, rigibra::Attitude const & attR
+			) const;
+
 		//! Descriptive information about this instance
 		std::string
 		infoString
@@ -171,6 +231,427 @@ namespace om
 
 	}; // Convention
 
+//
+// Packed convention identifier
+//
+
+	/*! \brief Dense numeric identifier for each (valid) Convention.
+	 *
+	 * The value is the position of the convention within the collection
+	 * Convention::allConventions(), i.e. in the range [0,55296), and
+	 * therefore fits in 16 bits. Conversions to/from Convention and
+	 * to/from the (human readable) Convention::numberEncoding() value
+	 * are provided by the constexpr functions below.
+	 */
+	using ConventionId = std::uint16_t;
+
+	//! Identifier value used for invalid conventions (e.g. Unknown order)
+	constexpr ConventionId sNullConventionId{ 0xFFFFu };
+
+	static_assert
+		( Convention::theNumConventions <= sNullConventionId
+		, "ConventionId type is too small for all conventions"
+		);
+
+namespace priv
+{
+	//! Sign patterns in order of allThreeSigns()
+	constexpr std::array<ThreeSigns, 8u> sAllSigns
+		{ ThreeSigns{ -1, -1, -1 }
+		, ThreeSigns{ -1, -1,  1 }
+		, ThreeSigns{ -1,  1, -1 }
+		, ThreeSigns{ -1,  1,  1 }
+		, ThreeSigns{  1, -1, -1 }
+		, ThreeSigns{  1, -1,  1 }
+		, ThreeSigns{  1,  1, -1 }
+		, ThreeSigns{  1,  1,  1 }
+		};
+
+	//! Index permutations in order of allThreeIndices()
+	constexpr std::array<ThreeIndices, 6u> sAllIndices
+		{ ThreeIndices{ 0u, 1u, 2u }
+		, ThreeIndices{ 0u, 2u, 1u }
+		, ThreeIndices{ 1u, 0u, 2u }
+		, ThreeIndices{ 1u, 2u, 0u }
+		, ThreeIndices{ 2u, 1u, 0u }
+		, ThreeIndices{ 2u, 0u, 1u }
+		};
+
+	//! Rotation plane sequences in order of allBivIndices()
+	constexpr std::array<ThreeIndices, 12u> sAllBivs
+		{ ThreeIndices{ 0u, 1u, 0u }
+		, ThreeIndices{ 0u, 1u, 2u }
+		, ThreeIndices{ 0u, 2u, 0u }
+		, ThreeIndices{ 0u, 2u, 1u }
+		, ThreeIndices{ 1u, 0u, 1u }
+		, ThreeIndices{ 1u, 0u, 2u }
+		, ThreeIndices{ 1u, 2u, 0u }
+		, ThreeIndices{ 1u, 2u, 1u }
+		, ThreeIndices{ 2u, 0u, 1u }
+		, ThreeIndices{ 2u, 0u, 2u }
+		, ThreeIndices{ 2u, 1u, 0u }
+		, ThreeIndices{ 2u, 1u, 2u }
+		};
+
+	//! Position of signs within sAllSigns [0,8)
+	constexpr
+	std::size_t
+	signsNdxFor
+		( ThreeSigns const & signs
+		)
+	{
+		return
+			( 4u * static_cast<std::size_t>(0 < signs[0])
+			+ 2u * static_cast<std::size_t>(0 < signs[1])
+			+ 1u * static_cast<std::size_t>(0 < signs[2])
+			);
+	}
+
+	//! Position of (permutation) indices within sAllIndices [0,6)
+	constexpr
+	std::size_t
+	indicesNdxFor
+		( ThreeIndices const & ndxs
+		)
+	{
+		// pairs by leading index, then by which of remaining is next
+		bool const isSecond
+			{ (2u == ndxs[0]) ? (0u == ndxs[1]) : (2u == ndxs[1]) };
+		return (2u * static_cast<std::size_t>(ndxs[0]) + isSecond);
+	}
+
+	//! Position of (rotation plane) indices within sAllBivs [0,12)
+	constexpr
+	std::size_t
+	bivNdxFor
+		( ThreeIndices const & ndxs
+		)
+	{
+		// rank of each index among values allowed after previous one
+		std::size_t const ndx0{ static_cast<std::size_t>(ndxs[0]) };
+		std::size_t const ndx1{ static_cast<std::size_t>(ndxs[1]) };
+		std::size_t const ndx2{ static_cast<std::size_t>(ndxs[2]) };
+		std::size_t const rank1{ ndx1 - static_cast<std::size_t>(ndx0 < ndx1) };
+		std::size_t const rank2{ ndx2 - static_cast<std::size_t>(ndx1 < ndx2) };
+		return (4u * ndx0 + 2u * rank1 + rank2);
+	}
+
+	//! Numeric encoding digit for signs (same as signsNdxFor) [0,8)
+	constexpr
+	std::int64_t
+	digitFor
+		( ThreeSigns const & signs
+		)
+	{
+		return static_cast<std::int64_t>(signsNdxFor(signs));
+	}
+
+	//! Numeric encoding digit for indices (base 3 value) [0,27)
+	constexpr
+	std::int64_t
+	digitFor
+		( ThreeIndices const & ndxs
+		)
+	{
+		return
+			( 9 * static_cast<std::int64_t>(ndxs[0])
+			+ 3 * static_cast<std::int64_t>(ndxs[1])
+			+ 1 * static_cast<std::int64_t>(ndxs[2])
+			);
+	}
+
+	//! Indices from numeric encoding digit (inverse of digitFor())
+	constexpr
+	ThreeIndices
+	indicesForDigit
+		( std::int64_t const & digit
+		)
+	{
+		return ThreeIndices
+			{ static_cast<std::uint8_t>((digit / 9) % 3)
+			, static_cast<std::uint8_t>((digit / 3) % 3)
+			, static_cast<std::uint8_t>(digit % 3)
+			};
+	}
+
+	//! True if each sign is either -1 or +1
+	constexpr
+	bool
+	isValidSigns
+		( ThreeSigns const & signs
+		)
+	{
+		return
+			(  ((-1 == signs[0]) || (1 == signs[0]))
+			&& ((-1 == signs[1]) || (1 == signs[1]))
+			&& ((-1 == signs[2]) || (1 == signs[2]))
+			);
+	}
+
+	//! True if ndxs is a permutation of {0,1,2} (one of sAllIndices)
+	constexpr
+	bool
+	isValidIndices
+		( ThreeIndices const & ndxs
+		)
+	{
+		return
+			(  (ndxs[0] < 3u) && (ndxs[1] < 3u) && (ndxs[2] < 3u)
+			&& (ndxs[0] != ndxs[1])
+			&& (ndxs[1] != ndxs[2])
+			&& (ndxs[2] != ndxs[0])
+			);
+	}
+
+	//! True if successive rotation planes differ (one of sAllBivs)
+	constexpr
+	bool
+	isValidBivs
+		( ThreeIndices const & ndxs
+		)
+	{
+		return
+			(  (ndxs[0] < 3u) && (ndxs[1] < 3u) && (ndxs[2] < 3u)
+			&& (ndxs[0] != ndxs[1])
+			&& (ndxs[1] != ndxs[2])
+			);
+	}
+
+	// Decimal digit pairs used by Convention::numberEncoding()
+	constexpr std::int64_t sNumIdBase{ 100 }; // for easy human interpretation
+	constexpr std::int64_t sNumPad   { 1000000000000 };
+	constexpr std::int64_t sNumOffSgn{   10000000000 };
+	constexpr std::int64_t sNumOffNdx{     100000000 };
+	constexpr std::int64_t sNumAngSgn{       1000000 };
+	constexpr std::int64_t sNumAngNdx{         10000 };
+	constexpr std::int64_t sNumBivNdx{           100 };
+	constexpr std::int64_t sNumOrder {             1 };
+
+} // [priv]
+
+	//! Position within allConventions() [0,48) - same as indexValue().
+	constexpr
+	std::size_t
+	offsetIndexFor
+		( ConventionOffset const & offConv
+		)
+	{
+		return
+			( priv::signsNdxFor(offConv.theOffSigns)
+			* priv::sAllIndices.size()
+			+ priv::indicesNdxFor(offConv.theOffIndices)
+			);
+	}
+
+	//! Position within allConventions() [0,576) - same as indexValue().
+	constexpr
+	std::size_t
+	angleIndexFor
+		( ConventionAngle const & angConv
+		)
+	{
+		return
+			( ( priv::signsNdxFor(angConv.theAngSigns)
+			  * priv::sAllIndices.size()
+			  + priv::indicesNdxFor(angConv.theAngIndices)
+			  ) * priv::sAllBivs.size()
+			+ priv::bivNdxFor(angConv.theBivIndices)
+			);
+	}
+
+	/*! \brief Identifier for convention (or sNullConventionId).
+	 *
+	 * The sNullConventionId value is returned unless all of the sign,
+	 * index and rotation plane fields (and the order) are valid, i.e.
+	 * unless the convention is one of allConventions().
+	 */
+	constexpr
+	ConventionId
+	conventionIdFor
+		( Convention const & convention
+		)
+	{
+		ConventionId convId{ sNullConventionId };
+		ConventionOffset const & offConv = convention.theConvOff;
+		ConventionAngle const & angConv = convention.theConvAng;
+		OrderTR const & order = convention.theOrder;
+		if (  ((TranRot == order) || (RotTran == order))
+		   && priv::isValidSigns(offConv.theOffSigns)
+		   && priv::isValidIndices(offConv.theOffIndices)
+		   && priv::isValidSigns(angConv.theAngSigns)
+		   && priv::isValidIndices(angConv.theAngIndices)
+		   && priv::isValidBivs(angConv.theBivIndices)
+		   )
+		{
+			// same order as the (nested) loops in allConventions()
+			convId = static_cast<ConventionId>
+				( ( offsetIndexFor(convention.theConvOff)
+				  * ConventionAngle::theNumConventions
+				  + angleIndexFor(convention.theConvAng)
+				  ) * 2u
+				+ static_cast<std::size_t>(convention.theOrder)
+				);
+		}
+		return convId;
+	}
+
+	//! Convention for identifier (default/invalid if out of range).
+	constexpr
+	Convention
+	conventionFor
+		( ConventionId const & convId
+		)
+	{
+		Convention convention{};
+		if (convId < Convention::theNumConventions)
+		{
+			using namespace priv;
+			constexpr std::size_t numNdx{ sAllIndices.size() };
+			constexpr std::size_t numBiv{ sAllBivs.size() };
+			// reverse of the (nested) loops in allConventions()
+			std::size_t const ndxOrd{ convId % 2u };
+			std::size_t const ndxAngOff{ convId / 2u };
+			std::size_t const ndxAng
+				{ ndxAngOff % ConventionAngle::theNumConventions };
+			std::size_t const ndxOff
+				{ ndxAngOff / ConventionAngle::theNumConventions };
+			convention = Convention
+				{ ConventionOffset
+					{ sAllSigns[ndxOff / numNdx]
+					, sAllIndices[ndxOff % numNdx]
+					}
+				, ConventionAngle
+					{ sAllSigns[ndxAng / (numNdx * numBiv)]
+					, sAllIndices[(ndxAng / numBiv) % numNdx]
+					, sAllBivs[ndxAng % numBiv]
+					}
+				, static_cast<OrderTR>(ndxOrd)
+				};
+		}
+		return convention;
+	}
+
+	//! Human readable number (as Convention::numberEncoding()) or -1.
+	constexpr
+	std::int64_t
+	numberEncodingFor
+		( ConventionId const & convId
+		)
+	{
+		std::int64_t numId{ -1 };
+		if (convId < Convention::theNumConventions)
+		{
+			Convention const convention{ conventionFor(convId) };
+			ConventionOffset const & off = convention.theConvOff;
+			ConventionAngle const & ang = convention.theConvAng;
+			using namespace priv;
+			numId =
+				( sNumPad    // so that all values show same width
+				+ sNumOffSgn * digitFor(off.theOffSigns) // 8
+				+ sNumOffNdx * digitFor(off.theOffIndices) // <32
+				+ sNumAngSgn * digitFor(ang.theAngSigns) // 8
+				+ sNumAngNdx * digitFor(ang.theAngIndices) // <32
+				+ sNumBivNdx * digitFor(ang.theBivIndices) // <32
+				+ sNumOrder  * static_cast<std::int64_t>(convention.theOrder)
+				);
+		}
+		return numId;
+	}
+
+	//! Identifier for human readable number (inverse numberEncodingFor()).
+	constexpr
+	ConventionId
+	conventionIdFromNumberEncoding
+		( std::int64_t const & numId
+		)
+	{
+		ConventionId convId{ sNullConventionId };
+		using namespace priv;
+		if ((sNumPad <= numId) && (numId < (2 * sNumPad)))
+		{
+			// extract digit pairs (least significant first)
+			std::array<std::int64_t, 6u> digits{};
+			std::int64_t curr{ numId };
+			for (std::size_t nn{0u} ; nn < digits.size() ; ++nn)
+			{
+				digits[nn] = curr % sNumIdBase;
+				curr = curr / sNumIdBase;
+			}
+			// digits: [0]:order, [1]:biv, [2]:angNdx, [3]:angSgn, ...
+			if ((digits[0] < 2) && (digits[3] < 8) && (digits[5] < 8))
+			{
+				Convention const convention
+					{ ConventionOffset
+						{ sAllSigns[digits[5]]
+						, indicesForDigit(digits[4])
+						}
+					, ConventionAngle
+						{ sAllSigns[digits[3]]
+						, indicesForDigit(digits[2])
+						, indicesForDigit(digits[1])
+						}
+					, static_cast<OrderTR>(digits[0])
+					};
+				// reject digits that are not one of the valid permutations
+				ConventionId const tmpId{ conventionIdFor(convention) };
+				if (numberEncodingFor(tmpId) == numId)
+				{
+					convId = tmpId;
+				}
+			}
+		}
+		return convId;
+	}
+
+//
+// Precomputed attitudes
+//
+
+	/*! \brief Attitudes for all ConventionAngle cases of one ParmGroup.
+	 *
+	 * The attitude produced by Convention::attitudeFor() depends only
+	 * on the ConventionAngle member, i.e. it is the same for each of
+	 * the 48 ConventionOffset cases and for both OrderTR values. This
+	 * table holds one attitude for each ConventionAngle::indexValue()
+	 * so that transforms for all (55296) conventions may be formed
+	 * from only 576 attitude evaluations. The table attitudes share
+	 * partial products (ref from()) and therefore agree with those of
+	 * Convention::attitudeFor() only to within roundoff.
+	 */
+	struct AttitudeTable
+	{
+		//! Parameter values from which attitudes are generated.
+		ParmGroup theParmGroup{};
+
+		//! Attitudes in order of ConventionAngle::allConventions().
+		std::vector<rigibra::Attitude> theAtts{};
+
+		//! Table with attitudes for all ConventionAngle cases.
+		static
+		AttitudeTable
+		from
+			( ParmGroup const & parmGroup
+			);
+
+		//! True if table contains an attitude for every angle convention.
+		bool
+		isValid
+			() const;
+
+		//! Precomputed - convention.attitudeFor(PG) to within roundoff.
+		rigibra::Attitude const &
+		attitudeFor
+			( Convention const & convention
+			) const;
+
+		//! Transform - convention.transformFor(theParmGroup) within roundoff.
+		rigibra::Transform
+		transformFor
+			( Convention const & convention
+			) const;
+
+	}; // AttitudeTable
+
 //
 // ConventionString en/de-coder
 //
@@ -205,11 +686,11 @@ namespace om
 			( Convention const & convention
 			);
 
-		//! Construct from canonical encoding.
+		//! Construct from (white space separated) canonical encoding.
 		static
 		ConventionString
 		from
-			( std::string const & encoding
+			( std::string_view const & encoding
 			);
 
 		//! Canonical string encoding for a convention
@@ -230,11 +711,70 @@ namespace om
 
 	}; // ConventionString
 
+	/*! \brief Fixed size (stack only) canonical encoding of a Convention.
+	 *
+	 * The text is the same as that of ConventionString::stringEncoding()
+	 * (for ConventionString::from(convention)), e.g.
+	 * "+-+ 210 ++- 201 102 1", but is formed without heap allocation.
+	 * Index values that are not single digits (which only occur for
+	 * invalid conventions) are represented by '?'.
+	 *
+	 * Decode the text with convention() (or conventionId()), which
+	 * reads the fields in the order they are written. (Note that
+	 * ConventionString::convention() reads the offset fields first).
+	 */
+	struct ConventionText
+	{
+		//! Five fields of three characters, an order digit and separators
+		static constexpr std::size_t sNumChars{ 5u*3u + 1u + 5u };
+
+		//! Characters of the encoding (not null terminated).
+		std::array<char, sNumChars> theChars{};
+
+		//! Text encoding for convention.
+		static
+		ConventionText
+		from
+			( Convention const & convention
+			);
+
+		//! Text encoding for convention with identifier convId.
+		static
+		ConventionText
+		from
+			( ConventionId const & convId
+			);
+
+		//! View of the encoding characters.
+		inline
+		std::string_view
+		view
+			() const
+		{
+			return std::string_view(theChars.data(), theChars.size());
+		}
+
+		//! Convention decoded (in place) from the text (inverse of from()).
+		Convention
+		convention
+			() const;
+
+		//! Identifier of convention() (sNullConventionId if invalid).
+		ConventionId
+		conventionId
+			() const;
+
+	}; // ConventionText
+
 //
 // Comparision operators
 //
 
-	//! True if all corresponding items of A are less than those of B
+	/*! \brief True if A is before B in allConventions() (invalid ones last)
+	 *
+	 * Invalid conventions (with sNullConventionId) are ordered by
+	 * their field values such that distinct ones are not equivalent.
+	 */
 	inline
 	bool
 	operator<
@@ -242,7 +782,32 @@ namespace om
 		, Convention const & convB
 		)
 	{
-		return (convA.numberEncoding() < convB.numberEncoding());
+		ConventionId const idA{ conventionIdFor(convA) };
+		ConventionId const idB{ conventionIdFor(convB) };
+		bool isLess{ idA < idB };
+		if ((sNullConventionId == idA) && (sNullConventionId == idB))
+		{
+			using Fields = std::tuple
+				< ThreeSigns const &, ThreeIndices const &
+				, ThreeSigns const &, ThreeIndices const &
+				, ThreeIndices const &, int
+				>;
+			auto const fieldsOf
+				{ [] (Convention const & conv)
+					{
+						return Fields
+							{ conv.theConvOff.theOffSigns
+							, conv.theConvOff.theOffIndices
+							, conv.theConvAng.theAngSigns
+							, conv.theConvAng.theAngIndices
+							, conv.theConvAng.theBivIndices
+							, static_cast<int>(conv.theOrder)
+							};
+					}
+				};
+			isLess = (fieldsOf(convA) < fieldsOf(convB));
+		}
+		return isLess;
 	}
 
 	//! True if ((!(A<B)) && (!(B<A)))
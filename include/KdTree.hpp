@@ -0,0 +1,224 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef OriMania_KdTree_INCL_
+#define OriMania_KdTree_INCL_
+
+/*! \file
+\brief Simple (static) k-d tree for fixed radius neighbor queries.
+
+Example:
+\snippet test_KdTree.cpp DoxyExample01
+
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+namespace om
+{
+	/*! \brief Balanced k-d tree over a (fixed) collection of points.
+	 *
+	 * The tree is implicit: for each index range [beg,end) of theNdxs,
+	 * the point at the middle position, mid=(beg+end)/2, splits the
+	 * remaining points on coordinate (depth % Dim) into those before
+	 * (not larger) and those after (not smaller) the middle position.
+	 *
+	 * Construction is O(N*log(N)) and a query within a small radius
+	 * visits O(log(N)) nodes plus those near the query point.
+	 */
+	template <std::size_t Dim>
+	struct KdTree
+	{
+		//! Point data type
+		using Point = std::array<double, Dim>;
+
+		//! Points (in original order) from which tree is constructed.
+		std::vector<Point> thePoints{};
+
+		//! Indices into thePoints arranged in (implicit) tree order.
+		std::vector<std::size_t> theNdxs{};
+
+		//! Tree containing (copy of) points.
+		inline
+		static
+		KdTree
+		from
+			( std::vector<Point> const & points
+			)
+		{
+			KdTree tree;
+			tree.thePoints = points;
+			tree.theNdxs.resize(points.size());
+			for (std::size_t nn{0u} ; nn < points.size() ; ++nn)
+			{
+				tree.theNdxs[nn] = nn;
+			}
+			tree.arrange(0u, tree.theNdxs.size(), 0u);
+			return tree;
+		}
+
+		//! Number of points in tree.
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theNdxs.size();
+		}
+
+		//! Square distance between two points.
+		inline
+		static
+		double
+		distSq
+			( Point const & pntA
+			, Point const & pntB
+			)
+		{
+			double sumSq{ 0. };
+			for (std::size_t dd{0u} ; dd < Dim ; ++dd)
+			{
+				double const delta{ pntA[dd] - pntB[dd] };
+				sumSq += delta * delta;
+			}
+			return sumSq;
+		}
+
+		/*! \brief Append indices of all points within radius of query.
+		 *
+		 * Indices (into thePoints) are appended to ndxs in tree order
+		 * (e.g. sort the result if order matters).
+		 */
+		inline
+		void
+		appendWithin
+			( Point const & query
+			, double const & radius
+			, std::vector<std::size_t> * const & ptNdxs
+			) const
+		{
+			if (ptNdxs)
+			{
+				appendWithin
+					(query, radius, radius*radius, 0u, size(), 0u, ptNdxs);
+			}
+		}
+
+		//! Indices (sorted) of all points within radius of query.
+		inline
+		std::vector<std::size_t>
+		indicesWithin
+			( Point const & query
+			, double const & radius
+			) const
+		{
+			std::vector<std::size_t> ndxs;
+			appendWithin(query, radius, &ndxs);
+			std::sort(ndxs.begin(), ndxs.end());
+			return ndxs;
+		}
+
+		//! Recursively partition theNdxs[beg,end) about middle element.
+		inline
+		void
+		arrange
+			( std::size_t const & beg
+			, std::size_t const & end
+			, std::size_t const & depth
+			)
+		{
+			if (1u < (end - beg))
+			{
+				std::size_t const mid{ (beg + end) / 2u };
+				std::size_t const dim{ depth % Dim };
+				std::vector<Point> const & points = thePoints;
+				std::nth_element
+					( theNdxs.begin() + beg
+					, theNdxs.begin() + mid
+					, theNdxs.begin() + end
+					, [&points, &dim]
+						( std::size_t const & ndxA
+						, std::size_t const & ndxB
+						)
+						{ return (points[ndxA][dim] < points[ndxB][dim]); }
+					);
+				arrange(beg, mid, depth + 1u);
+				arrange(mid + 1u, end, depth + 1u);
+			}
+		}
+
+		//! Recursive search of theNdxs[beg,end) (ref public overload)
+		inline
+		void
+		appendWithin
+			( Point const & query
+			, double const & radius
+			, double const & radiusSq
+			, std::size_t const & beg
+			, std::size_t const & end
+			, std::size_t const & depth
+			, std::vector<std::size_t> * const & ptNdxs
+			) const
+		{
+			if (beg < end)
+			{
+				std::size_t const mid{ (beg + end) / 2u };
+				std::size_t const dim{ depth % Dim };
+				std::size_t const & midNdx = theNdxs[mid];
+				Point const & midPnt = thePoints[midNdx];
+				if (! (radiusSq < distSq(query, midPnt)))
+				{
+					ptNdxs->emplace_back(midNdx);
+				}
+
+				// search sides that can contain points within radius
+				double const delta{ query[dim] - midPnt[dim] };
+				if (! (radius < delta))
+				{
+					appendWithin
+						(query, radius, radiusSq, beg, mid, depth + 1u, ptNdxs);
+				}
+				if (! (delta < -radius))
+				{
+					appendWithin
+						( query, radius, radiusSq
+						, mid + 1u, end, depth + 1u, ptNdxs
+						);
+				}
+			}
+		}
+
+	}; // KdTree
+
+} // [om]
+
+
+#endif // OriMania_KdTree_INCL_
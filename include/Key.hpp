@@ -36,8 +36,15 @@ Example:
 
 */
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <string>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 
 namespace om
@@ -121,12 +128,132 @@ namespace om
 		, KeyPair const & pairB
 		)
 	{
-		// use logic from std::pair
-		std::pair const sPairA{ pairA.theKeyFrom, pairA.theKeyInto };
-		std::pair const sPairB{ pairB.theKeyFrom, pairB.theKeyInto };
-		return (sPairA < sPairB);
+		// same logic as std::pair (but compare references, not copies)
+		return
+			(  std::tie(pairA.theKeyFrom, pairA.theKeyInto)
+			 < std::tie(pairB.theKeyFrom, pairB.theKeyInto)
+			);
 	}
 
+	//! Dense index value associated with a SenKey (ref SenRegistry).
+	using SenNdx = std::size_t;
+
+	/*! \brief Interning of SenKey values as dense SenNdx index values.
+	 *
+	 * Intended to be created once (e.g. after data are loaded) so that
+	 * subsequent processing can use contiguous arrays indexed by SenNdx
+	 * instead of (string comparing) std::map<SenKey, ...> containers.
+	 * Keys are held in sorted order, so that SenNdx order is the same
+	 * as the iteration order of std::map<SenKey, ...> containers. Key
+	 * values are needed again only for reporting, i.e. via keyFor().
+	 */
+	struct SenRegistry
+	{
+		//! Unique keys in sorted order (position is the SenNdx value).
+		std::vector<SenKey> theKeys{};
+
+		//! Index value returned by ndxFor() for unregistered keys.
+		static constexpr SenNdx sNullNdx
+			{ std::numeric_limits<SenNdx>::max() };
+
+		//! Registry for the (sorted, unique) collection of keys.
+		inline
+		static
+		SenRegistry
+		from
+			( std::vector<SenKey> keys
+			)
+		{
+			std::sort(keys.begin(), keys.end());
+			keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+			return SenRegistry{ keys };
+		}
+
+		//! Registry for all of the keys in any of the keyVals maps.
+		template <typename ... Types>
+		inline
+		static
+		SenRegistry
+		fromKeysOf
+			( std::map<SenKey, Types> const & ... keyVals
+			)
+		{
+			std::vector<SenKey> keys;
+			( ( std::transform
+				( keyVals.cbegin(), keyVals.cend()
+				, std::back_inserter(keys)
+				, [] (auto const & keyVal) { return keyVal.first; }
+				)
+			  ), ...
+			);
+			return from(keys);
+		}
+
+		//! Number of registered keys (index values are [0,size()) )
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theKeys.size();
+		}
+
+		//! Index for senKey (or sNullNdx if senKey is not registered).
+		inline
+		SenNdx
+		ndxFor
+			( SenKey const & senKey
+			) const
+		{
+			SenNdx ndx{ sNullNdx };
+			std::vector<SenKey>::const_iterator const itFind
+				{ std::lower_bound(theKeys.cbegin(), theKeys.cend(), senKey) };
+			if ((theKeys.cend() != itFind) && (senKey == *itFind))
+			{
+				ndx = static_cast<SenNdx>
+					(std::distance(theKeys.cbegin(), itFind));
+			}
+			return ndx;
+		}
+
+		//! Key value associated with (valid) senNdx.
+		inline
+		SenKey const &
+		keyFor
+			( SenNdx const & senNdx
+			) const
+		{
+			return theKeys[senNdx];
+		}
+
+		/*! \brief Values from keyVals arranged in SenNdx order.
+		 *
+		 * Entries for registered keys which are not in keyVals are
+		 * set to the fillValue.
+		 */
+		template <typename Type>
+		inline
+		std::vector<Type>
+		denseFrom
+			( std::map<SenKey, Type> const & keyVals
+			, Type const & fillValue
+			) const
+		{
+			std::vector<Type> values(theKeys.size(), fillValue);
+			for (typename std::map<SenKey, Type>::value_type
+				const & keyVal : keyVals)
+			{
+				SenNdx const ndx{ ndxFor(keyVal.first) };
+				if (sNullNdx != ndx)
+				{
+					values[ndx] = keyVal.second;
+				}
+			}
+			return values;
+		}
+
+	}; // SenRegistry
+
 } // [om]
 
 
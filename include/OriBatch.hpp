@@ -0,0 +1,328 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef OriMania_OriBatch_INCL_
+#define OriMania_OriBatch_INCL_
+
+/*! \file
+\brief Structure-of-arrays orientation collections and batch kernels.
+
+The kernels (compose, inverse and the closed form fit metric) are
+implemented in OriBatch.cpp as simple loops over contiguous arrays
+of doubles. There, they are compiled for several instruction sets
+(where supported by the compiler) with selection at runtime.
+
+All arithmetic is performed in the same (non-contracted) order for
+every instruction set and for the single element functions, so that
+results are identical regardless of which kernel variant is used.
+
+Example:
+\snippet test_OriBatch.cpp DoxyExample01
+
+*/
+
+
+#include "Orientation.hpp"
+
+#include <Engabra>
+#include <Rigibra>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+namespace om
+{
+	/*! \brief Numeric parts of one SenOri (rotor and location).
+	 *
+	 * The SenOri maps vector v into R(v - t) where t is theLoc and
+	 * R is the rotation by the (unitary) spinor with scalar part theSca
+	 * and bivector (dual) components theBiv, i.e.
+	 * \verbatim
+	 *   R(v) = v - 2*theSca*(theBiv x v) + 2*theBiv x (theBiv x v)
+	 * \endverbatim
+	 */
+	struct OriParts
+	{
+		double theSca{ engabra::g3::null<double>() };
+		std::array<double, 3u> theBiv
+			{ engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			};
+		std::array<double, 3u> theLoc
+			{ engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			};
+
+		//! Parts extracted from ori.
+		inline
+		static
+		OriParts
+		from
+			( SenOri const & ori
+			)
+		{
+			engabra::g3::Spinor const & spin = ori.theAtt.spinor();
+			return OriParts
+				{ spin.theSca[0]
+				, { spin.theBiv[0], spin.theBiv[1], spin.theBiv[2] }
+				, { ori.theLoc[0], ori.theLoc[1], ori.theLoc[2] }
+				};
+		}
+
+		//! Orientation with these parts.
+		inline
+		SenOri
+		ori
+			() const
+		{
+			using namespace rigibra;
+			return SenOri
+				{ Location{ theLoc[0], theLoc[1], theLoc[2] }
+				, Attitude
+					{ engabra::g3::Spinor
+						{ theSca, theBiv[0], theBiv[1], theBiv[2] }
+					}
+				};
+		}
+
+	}; // OriParts
+
+	/*! \brief Collection of orientations in structure-of-arrays form.
+	 *
+	 * Each component of the OriParts is stored in its own contiguous
+	 * array such that batch kernels can process many orientations (e.g.
+	 * one for each of a block of conventions) per instruction.
+	 */
+	struct OriBatch
+	{
+		std::vector<double> theScas{};
+		std::array<std::vector<double>, 3u> theBivs{};
+		std::array<std::vector<double>, 3u> theLocs{};
+
+		//! Collection with (uninitialized) space for numOris.
+		inline
+		static
+		OriBatch
+		withSize
+			( std::size_t const & numOris
+			)
+		{
+			OriBatch batch;
+			batch.resize(numOris);
+			return batch;
+		}
+
+		//! Collection containing each of oris (in order).
+		inline
+		static
+		OriBatch
+		from
+			( std::vector<SenOri> const & oris
+			)
+		{
+			OriBatch batch;
+			batch.reserve(oris.size());
+			for (SenOri const & ori : oris)
+			{
+				batch.emplace_back(ori);
+			}
+			return batch;
+		}
+
+		//! Number of orientations in collection.
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theScas.size();
+		}
+
+		//! True if collection has no orientations.
+		inline
+		bool
+		empty
+			() const
+		{
+			return theScas.empty();
+		}
+
+		//! Allocate space for numOris (e.g. prior to emplace_back()).
+		inline
+		void
+		reserve
+			( std::size_t const & numOris
+			)
+		{
+			theScas.reserve(numOris);
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				theBivs[kk].reserve(numOris);
+				theLocs[kk].reserve(numOris);
+			}
+		}
+
+		//! Change collection size to numOris.
+		inline
+		void
+		resize
+			( std::size_t const & numOris
+			)
+		{
+			theScas.resize(numOris);
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				theBivs[kk].resize(numOris);
+				theLocs[kk].resize(numOris);
+			}
+		}
+
+		//! Append parts to end of collection.
+		inline
+		void
+		emplace_back
+			( OriParts const & parts
+			)
+		{
+			theScas.emplace_back(parts.theSca);
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				theBivs[kk].emplace_back(parts.theBiv[kk]);
+				theLocs[kk].emplace_back(parts.theLoc[kk]);
+			}
+		}
+
+		//! Append ori to end of collection.
+		inline
+		void
+		emplace_back
+			( SenOri const & ori
+			)
+		{
+			emplace_back(OriParts::from(ori));
+		}
+
+		//! Set element at ndx to parts.
+		inline
+		void
+		setParts
+			( std::size_t const & ndx
+			, OriParts const & parts
+			)
+		{
+			theScas[ndx] = parts.theSca;
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				theBivs[kk][ndx] = parts.theBiv[kk];
+				theLocs[kk][ndx] = parts.theLoc[kk];
+			}
+		}
+
+		//! Parts for element at ndx.
+		inline
+		OriParts
+		partsAt
+			( std::size_t const & ndx
+			) const
+		{
+			return OriParts
+				{ theScas[ndx]
+				, { theBivs[0][ndx], theBivs[1][ndx], theBivs[2][ndx] }
+				, { theLocs[0][ndx], theLocs[1][ndx], theLocs[2][ndx] }
+				};
+		}
+
+		//! Orientation for element at ndx.
+		inline
+		SenOri
+		oriAt
+			( std::size_t const & ndx
+			) const
+		{
+			return partsAt(ndx).ori();
+		}
+
+	}; // OriBatch
+
+
+	//
+	// Single element functions (same arithmetic as batch kernels)
+	//
+
+	//! Fit error statistic (closed form basis RMSE) for one transform.
+	double
+	rmseRotorFor
+		( OriParts const & parts
+		);
+
+	//! Fit error statistic between parts2wX and parts1wX.
+	double
+	rmseRotorBetween
+		( OriParts const & parts1wX
+		, OriParts const & parts2wX
+		);
+
+
+	//
+	// Batch kernels
+	//
+
+	//! Inverse of each orientation in oris.
+	OriBatch
+	inverseOf
+		( OriBatch const & oris
+		);
+
+	//! Composition (oris2[k] * oris1[k]) for each element of (same size) oris.
+	OriBatch
+	composedOf
+		( OriBatch const & oris2
+		, OriBatch const & oris1
+		);
+
+	/*! \brief Add rmseRotorBetween(oris1wX[k], parts2wX) into sums[k].
+	 *
+	 * Elements k in the range [ndxBeg, ndxEnd) of oris1wX are compared
+	 * with the (same) parts2wX and the fit errors are added to the
+	 * corresponding values of sums (which must have ndxEnd elements).
+	 */
+	void
+	addRmseRotorErrors
+		( double * const & sums
+		, OriBatch const & oris1wX
+		, OriParts const & parts2wX
+		, std::size_t const & ndxBeg
+		, std::size_t const & ndxEnd
+		);
+
+} // [om]
+
+
+#endif // OriMania_OriBatch_INCL_
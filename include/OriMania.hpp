@@ -36,9 +36,12 @@
 // Include the key files
 
 #include "Analysis.hpp"
+#include "BoxCache.hpp"
 #include "Convention.hpp"
 #include "io.hpp"
 #include "Orientation.hpp"
+#include "Parallel.hpp"
+#include "Profile.hpp"
 
 #include <string>
 
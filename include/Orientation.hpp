@@ -38,10 +38,13 @@ Example:
 #include "Key.hpp"
 #include "ParmGroup.hpp"
 #include "Convention.hpp"
+#include "Parallel.hpp"
+#include "Profile.hpp"
 
 #include <Rigibra>
 
 #include <map>
+#include <vector>
 
 
 namespace om
@@ -68,6 +71,103 @@ namespace om
 		return keyOris;
 	}
 
+	//! Attitude tables (for all angle conventions) for each ParmGroup.
+	inline
+	std::map<om::SenKey, om::AttitudeTable>
+	attitudeTablesFor
+		( std::map<om::SenKey, om::ParmGroup> const & keyPGs
+		)
+	{
+		using namespace om;
+		std::map<SenKey, AttitudeTable> keyTables;
+		for (std::map<SenKey, ParmGroup>::value_type const & keyPG : keyPGs)
+		{
+			keyTables.emplace_hint
+				( keyTables.end()
+				, std::make_pair(keyPG.first, AttitudeTable::from(keyPG.second))
+				);
+		}
+		return keyTables;
+	}
+
+	/*! \brief Attitude tables for each ParmGroup arranged in SenNdx order.
+	 *
+	 * Entries for registered keys not present in keyPGs are default
+	 * (not AttitudeTable::isValid()) tables.
+	 */
+	inline
+	std::vector<om::AttitudeTable>
+	attitudeTablesFor
+		( om::SenRegistry const & registry
+		, std::map<om::SenKey, om::ParmGroup> const & keyPGs
+		)
+	{
+		using namespace om;
+		std::vector<AttitudeTable> tables(registry.size());
+		for (std::map<SenKey, ParmGroup>::value_type const & keyPG : keyPGs)
+		{
+			SenNdx const ndx{ registry.ndxFor(keyPG.first) };
+			if (SenRegistry::sNullNdx != ndx)
+			{
+				tables[ndx] = AttitudeTable::from(keyPG.second);
+			}
+		}
+		return tables;
+	}
+
+	/*! \brief Orientations from precomputed attitude tables.
+	 *
+	 * Same result as keyOrisFor(keyPGs, useConvention) with keyTables
+	 * from attitudeTablesFor(keyPGs), but attitudes are looked up rather
+	 * than recomputed (e.g. for use in loops over many conventions).
+	 */
+	inline
+	std::map<om::SenKey, om::SenOri>
+	keyOrisFor
+		( std::map<om::SenKey, om::AttitudeTable> const & keyTables
+		, om::Convention const & useConvention
+		)
+	{
+		using namespace om;
+		std::map<SenKey, SenOri> keyOris;
+		for (std::map<SenKey, AttitudeTable>::value_type
+			const & keyTable : keyTables)
+		{
+			SenKey const & senKey = keyTable.first;
+			AttitudeTable const & table = keyTable.second;
+			keyOris.emplace_hint
+				( keyOris.end()
+				, std::make_pair(senKey, table.transformFor(useConvention))
+				);
+		}
+		return keyOris;
+	}
+
+	/*! \brief Orientations (in SenNdx order) from dense attitude tables.
+	 *
+	 * Same values as keyOrisFor(keyTables, useConvention) but indexed
+	 * by SenNdx. Entries associated with invalid tables are left with
+	 * default values.
+	 */
+	inline
+	std::vector<om::SenOri>
+	orisFor
+		( std::vector<om::AttitudeTable> const & tables
+		, om::Convention const & useConvention
+		)
+	{
+		using namespace om;
+		std::vector<SenOri> oris(tables.size());
+		for (std::size_t ndx{0u} ; ndx < tables.size() ; ++ndx)
+		{
+			if (tables[ndx].isValid())
+			{
+				oris[ndx] = tables[ndx].transformFor(useConvention);
+			}
+		}
+		return oris;
+	}
+
 	/*! \brief Generate all (non trivial) combinations of relative orientation.
 	 *
 	 * Generates relative orientations for all combinations of KeyPair
@@ -108,10 +208,137 @@ namespace om
 				ros.emplace_hint(ros.end(), std::make_pair(keyPair, ro2w1));
 			}
 		}
+		prof::count(prof::Counter::Inverse, ros.size()); // one per pair
 		return ros;
 	}
 
 
+	/*! \brief Relative orientation (2 w.r.t. 1) between indexed sensors.
+	 *
+	 * Element of flat (contiguous) relative orientation collections,
+	 * e.g. as produced by relativeOrientationBetweens(oris, ...) and
+	 * sorted by (theNdx1, theNdx2) pair.
+	 */
+	struct NdxRelOri
+	{
+		//! Sensor index (SenNdx) of the "from" orientation (key1)
+		SenNdx theNdx1{ SenRegistry::sNullNdx };
+
+		//! Sensor index (SenNdx) of the "into" orientation (key2)
+		SenNdx theNdx2{ SenRegistry::sNullNdx };
+
+		//! Relative orientation of sensor theNdx2 w.r.t. sensor theNdx1.
+		SenOri theRelOri{};
+
+	}; // NdxRelOri
+
+	/*! \brief Flat relative orientations between each pair of sensors.
+	 *
+	 * Same as relativeOrientationBetweens(keyOris) for sensors (in
+	 * SenNdx order) at the senNdxs positions of oris. The senNdxs
+	 * values are expected to be unique and sorted (e.g. for valid
+	 * sensors only). The returned collection is sorted by pair and
+	 * contains (M*(M-1)/2) entries for M=senNdxs.size().
+	 *
+	 * The ROs are computed in numThreads concurrent groups (each with
+	 * the same ndx1) and are written directly into their final place.
+	 */
+	inline
+	std::vector<NdxRelOri>
+	relativeOrientationBetweens
+		( std::vector<SenOri> const & oris
+		, std::vector<SenNdx> const & senNdxs
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		std::size_t const numSen{ senNdxs.size() };
+		std::size_t const numROs{ (numSen * (numSen - 1u)) / 2u };
+		std::vector<NdxRelOri> ndxROs;
+		if (1u < numSen)
+		{
+			ndxROs.resize(numROs);
+
+			// ROs for ndx1=senNdxs[nn1] and all subsequent sensors
+			auto const evalGroup
+				{ [&ndxROs, &oris, &senNdxs, &numSen]
+					( std::size_t const nn1
+					)
+				{
+					// position of first pair (nn1,nn1+1) in sorted output
+					std::size_t pNdx
+						{ nn1 * numSen - (nn1 * (nn1 + 1u)) / 2u };
+					SenNdx const & ndx1 = senNdxs[nn1];
+					SenOri const oriRw1{ inverse(oris[ndx1]) };
+					for (std::size_t nn2{nn1 + 1u} ; nn2 < numSen ; ++nn2)
+					{
+						SenNdx const & ndx2 = senNdxs[nn2];
+						SenOri const ro2w1{ oris[ndx2] * oriRw1 };
+						ndxROs[pNdx++] = NdxRelOri{ ndx1, ndx2, ro2w1 };
+					}
+				}
+				};
+
+			par::forEachIndex(numSen - 1u, numThreads, evalGroup);
+			prof::count(prof::Counter::Inverse, numSen - 1u);
+		}
+		return ndxROs;
+	}
+
+	//! Flat relative orientations (as above) for every one of oris.
+	inline
+	std::vector<NdxRelOri>
+	relativeOrientationBetweens
+		( std::vector<SenOri> const & oris
+		, std::size_t const & numThreads = 1u
+		)
+	{
+		std::vector<SenNdx> senNdxs(oris.size());
+		for (SenNdx ndx{0u} ; ndx < senNdxs.size() ; ++ndx)
+		{
+			senNdxs[ndx] = ndx;
+		}
+		return relativeOrientationBetweens(oris, senNdxs, numThreads);
+	}
+
+	//! Flat relative orientations (with keys in registry) from keyed ones.
+	inline
+	std::vector<NdxRelOri>
+	ndxRelOrisFor
+		( SenRegistry const & registry
+		, std::map<KeyPair, SenOri> const & relKeyOris
+		)
+	{
+		std::vector<NdxRelOri> ndxROs;
+		ndxROs.reserve(relKeyOris.size());
+		for (std::map<KeyPair, SenOri>::value_type
+			const & relKeyOri : relKeyOris)
+		{
+			KeyPair const & keyPair = relKeyOri.first;
+			SenNdx const ndx1{ registry.ndxFor(keyPair.key1()) };
+			SenNdx const ndx2{ registry.ndxFor(keyPair.key2()) };
+			if ( (SenRegistry::sNullNdx != ndx1)
+			  && (SenRegistry::sNullNdx != ndx2)
+			   )
+			{
+				ndxROs.emplace_back(NdxRelOri{ ndx1, ndx2, relKeyOri.second });
+			}
+		}
+		return ndxROs;
+	}
+
+	//! Flat relative orientations for keys in keyTables (in map order).
+	inline
+	std::vector<NdxRelOri>
+	ndxRelOrisFor
+		( std::map<SenKey, AttitudeTable> const & keyTables
+		, std::map<KeyPair, SenOri> const & relKeyOris
+		)
+	{
+		// index values are the same as positions in (sorted) keyTables
+		return ndxRelOrisFor(SenRegistry::fromKeysOf(keyTables), relKeyOris);
+	}
+
+
 } // [om]
 
 #endif // OriMania_Orientation_INCL_
@@ -0,0 +1,170 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#ifndef OriMania_Parallel_INCL_
+#define OriMania_Parallel_INCL_
+
+/*! \file
+\brief Simple utilities for distributing independent work over threads.
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace om
+{
+
+/*! \brief Functions supporting (simple) multi-threaded processing.
+ *
+ */
+namespace par
+{
+	//! Number of hardware threads available (or 1 if unknown).
+	inline
+	std::size_t
+	hardwareThreadCount
+		()
+	{
+		std::size_t const numHw
+			{ static_cast<std::size_t>(std::thread::hardware_concurrency()) };
+		return std::max(numHw, std::size_t{ 1u });
+	}
+
+	/*! \brief Call func(ndxBeg, ndxEnd) for blocks spanning [0,numItems).
+	 *
+	 * The index range is split into (at most) numThreads contiguous
+	 * blocks of (nearly) equal size. Each block is processed on its
+	 * own thread, with the final block processed on the calling thread.
+	 * The function returns after all blocks have been processed.
+	 *
+	 * The func is called concurrently and therefore it should only
+	 * modify data associated with indices inside its own block.
+	 */
+	template <typename Func>
+	inline
+	void
+	forEachBlock
+		( std::size_t const & numItems
+		, std::size_t const & numThreads
+		, Func const & func
+		)
+	{
+		std::size_t const numBlocks
+			{ std::max(std::size_t{ 1u }, std::min(numThreads, numItems)) };
+		std::size_t const blockSize{ numItems / numBlocks };
+		std::size_t const numExtra{ numItems % numBlocks };
+
+		std::vector<std::thread> threads;
+		threads.reserve(numBlocks);
+		std::size_t ndxBeg{ 0u };
+		for (std::size_t nBlock{0u} ; nBlock < numBlocks ; ++nBlock)
+		{
+			// first few blocks absorb the remainder
+			std::size_t ndxEnd{ ndxBeg + blockSize };
+			if (nBlock < numExtra)
+			{
+				++ndxEnd;
+			}
+
+			if ((nBlock + 1u) < numBlocks)
+			{
+				threads.emplace_back(std::thread(func, ndxBeg, ndxEnd));
+			}
+			else
+			{
+				func(ndxBeg, ndxEnd); // last (or only) block on this thread
+			}
+			ndxBeg = ndxEnd;
+		}
+
+		for (std::thread & thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	/*! \brief Call func(ndx) for each ndx in [0,numItems) using a pool.
+	 *
+	 * A pool of (at most) numThreads workers is started (one of which
+	 * is the calling thread). Each worker repeatedly claims the next
+	 * unprocessed index (from a shared atomic counter) until all of
+	 * the indices have been claimed. Workers that finish quickly
+	 * therefore take on more of the items, which balances the load
+	 * when processing times vary from item to item.
+	 *
+	 * The order in which indices are processed is not specified, hence
+	 * func should record results by index (e.g. into a pre-sized array)
+	 * if the original order is to be preserved. The function returns
+	 * after all of the items have been processed.
+	 */
+	template <typename Func>
+	inline
+	void
+	forEachIndex
+		( std::size_t const & numItems
+		, std::size_t const & numThreads
+		, Func const & func
+		)
+	{
+		std::atomic<std::size_t> nextNdx{ 0u };
+		auto const worker
+			{ [&nextNdx, &numItems, &func]
+				()
+			{
+				for (std::size_t ndx{ nextNdx++ } ; ndx < numItems
+					; ndx = nextNdx++)
+				{
+					func(ndx);
+				}
+			}
+			};
+
+		std::size_t const numWorkers
+			{ std::max(std::size_t{ 1u }, std::min(numThreads, numItems)) };
+		std::vector<std::thread> threads;
+		threads.reserve(numWorkers);
+		for (std::size_t nWork{1u} ; nWork < numWorkers ; ++nWork)
+		{
+			threads.emplace_back(std::thread(worker));
+		}
+		worker(); // calling thread participates as well
+
+		for (std::thread & thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+} // [par]
+
+} // [om]
+
+
+#endif // OriMania_Parallel_INCL_
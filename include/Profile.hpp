@@ -0,0 +1,525 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef OriMania_Profile_INCL_
+#define OriMania_Profile_INCL_
+
+/*! \file
+\brief Stage timing and call counters (for reporting with --profile).
+
+Instrumentation is active only if OriMania_Profile_Enable is defined
+(ref CMake option OriMania_PROFILE). Otherwise, the StageTimer and the
+count() function are empty and compile out entirely, and the values
+reported by Snapshot::current() are all zero.
+
+The macro must be defined (or not) consistently for the library and for
+all code that includes this header.
+
+Example:
+\snippet test_Profile.cpp DoxyExample01
+
+*/
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+
+namespace om
+{
+
+/*! \brief Instrumentation for the main processing stages.
+ *
+ */
+namespace prof
+{
+	//! True if instrumentation is compiled into this build.
+#if defined(OriMania_Profile_Enable)
+	constexpr bool sIsEnabled{ true };
+#else
+	constexpr bool sIsEnabled{ false };
+#endif
+
+	//! Main processing stages (for which time is accumulated).
+	enum class Stage : std::size_t
+	{
+		  Load = 0u     //!< Parsing input files
+		, Conventions   //!< Generating conventions to be considered
+		, IndEOs        //!< Constructing Ind exterior orientations
+		, RelOris       //!< Generating relative orientations (Box and Ind)
+		, Fit           //!< Evaluating fit errors for conventions
+		, Select        //!< Selecting best (top-K) fits and trial results
+		, Report        //!< Writing results
+
+	}; // Stage
+
+	//! Number of Stage values.
+	constexpr std::size_t sNumStages{ 7u };
+
+	//! Events that are counted.
+	enum class Counter : std::size_t
+	{
+		  TransformFor = 0u //!< Calls to Convention::transformFor()
+		, Inverse           //!< Orientation inverses (incl. batch elements)
+		, Conventions       //!< Conventions evaluated (scored)
+
+	}; // Counter
+
+	//! Number of Counter values.
+	constexpr std::size_t sNumCounters{ 3u };
+
+	//! Name for stage (as used in reports).
+	inline
+	std::string
+	nameFor
+		( Stage const & stage
+		)
+	{
+		static std::array<std::string, sNumStages> const names
+			{ "load"
+			, "conventions"
+			, "indEOs"
+			, "relOris"
+			, "fit"
+			, "select"
+			, "report"
+			};
+		return names[static_cast<std::size_t>(stage)];
+	}
+
+	//! Name for counter (as used in reports).
+	inline
+	std::string
+	nameFor
+		( Counter const & counter
+		)
+	{
+		static std::array<std::string, sNumCounters> const names
+			{ "transformFor"
+			, "inverse"
+			, "conventions"
+			};
+		return names[static_cast<std::size_t>(counter)];
+	}
+
+	//! Values accumulated by instrumentation (at one point in time).
+	struct Snapshot
+	{
+		//! Time spent in each stage (summed over all threads).
+		std::array<double, sNumStages> theStageSeconds{};
+
+		//! Number of times each stage has been entered.
+		std::array<std::uint64_t, sNumStages> theStageCalls{};
+
+		//! Number of events for each counter.
+		std::array<std::uint64_t, sNumCounters> theCounts{};
+
+		//! Elapsed (wall clock) time since last reset().
+		double theWallSeconds{ 0. };
+
+		//! Current values (all zero unless instrumentation is enabled).
+		inline
+		static
+		Snapshot
+		current
+			();
+
+		//! Seconds for stage
+		inline
+		double
+		secondsFor
+			( Stage const & stage
+			) const
+		{
+			return theStageSeconds[static_cast<std::size_t>(stage)];
+		}
+
+		//! Count of events
+		inline
+		std::uint64_t
+		countFor
+			( Counter const & counter
+			) const
+		{
+			return theCounts[static_cast<std::size_t>(counter)];
+		}
+
+		//! Conventions evaluated per (wall clock) second - or zero.
+		inline
+		double
+		conventionsPerSecond
+			() const
+		{
+			double rate{ 0. };
+			if (0. < theWallSeconds)
+			{
+				rate = static_cast<double>(countFor(Counter::Conventions))
+					/ theWallSeconds;
+			}
+			return rate;
+		}
+
+		//! Summary report with one line per item (each prefixed by "# ").
+		inline
+		std::string
+		infoString
+			() const
+		{
+			std::ostringstream oss;
+			oss << "# Profile:";
+			if (! sIsEnabled)
+			{
+				oss << " not available (built without OriMania_PROFILE)\n";
+			}
+			else
+			{
+				oss << " stage times are summed over threads\n";
+				oss << std::fixed << std::setprecision(6u);
+				for (std::size_t nn{0u} ; nn < sNumStages ; ++nn)
+				{
+					oss << "#   stage " << std::setw(12u)
+						<< nameFor(static_cast<Stage>(nn))
+						<< " : " << std::setw(12u) << theStageSeconds[nn]
+						<< " s  calls: " << theStageCalls[nn]
+						<< '\n';
+				}
+				for (std::size_t nn{0u} ; nn < sNumCounters ; ++nn)
+				{
+					oss << "#   count " << std::setw(12u)
+						<< nameFor(static_cast<Counter>(nn))
+						<< " : " << theCounts[nn]
+						<< '\n';
+				}
+				oss << "#   wall time : " << theWallSeconds << " s\n";
+				oss << "#   conventions/s : " << std::setprecision(1u)
+					<< conventionsPerSecond() << '\n';
+			}
+			return oss.str();
+		}
+
+		//! Values in JSON format.
+		inline
+		std::string
+		json
+			() const
+		{
+			std::ostringstream oss;
+			oss << std::setprecision(9u);
+			oss << "{\n";
+			oss << "  \"enabled\": " << (sIsEnabled ? "true" : "false")
+				<< ",\n";
+			oss << "  \"wallSeconds\": " << theWallSeconds << ",\n";
+			oss << "  \"stages\": [";
+			for (std::size_t nn{0u} ; nn < sNumStages ; ++nn)
+			{
+				oss << ((0u < nn) ? "," : "") << "\n    { \"stage\": \""
+					<< nameFor(static_cast<Stage>(nn)) << "\""
+					<< ", \"seconds\": " << theStageSeconds[nn]
+					<< ", \"calls\": " << theStageCalls[nn]
+					<< " }";
+			}
+			oss << "\n  ],\n";
+			oss << "  \"counts\": {";
+			for (std::size_t nn{0u} ; nn < sNumCounters ; ++nn)
+			{
+				oss << ((0u < nn) ? "," : "") << "\n    \""
+					<< nameFor(static_cast<Counter>(nn)) << "\": "
+					<< theCounts[nn];
+			}
+			oss << "\n  },\n";
+			oss << "  \"conventionsPerSecond\": " << conventionsPerSecond()
+				<< '\n';
+			oss << "}\n";
+			return oss.str();
+		}
+
+	}; // Snapshot
+
+#if defined(OriMania_Profile_Enable)
+
+	//! Clock used for all stage timing.
+	using Clock = std::chrono::steady_clock;
+
+	//! Shared (process wide) accumulators.
+	struct Totals
+	{
+		std::array<std::atomic<std::uint64_t>, sNumStages> theStageNanos{};
+		std::array<std::atomic<std::uint64_t>, sNumStages> theStageCalls{};
+		std::array<std::atomic<std::uint64_t>, sNumCounters> theCounts{};
+		std::atomic<Clock::rep> theStartTicks
+			{ Clock::now().time_since_epoch().count() };
+
+	}; // Totals
+
+	//! The process wide accumulators.
+	inline
+	Totals &
+	totals
+		()
+	{
+		static Totals sTotals;
+		return sTotals;
+	}
+
+	/*! \brief Counts accumulated by one thread (without synchronization).
+	 *
+	 * The counts are added to the shared totals() when flushed: at the
+	 * end of each StageTimer, by Snapshot::current() (for the calling
+	 * thread) and when the thread ends (e.g. before it is joined).
+	 */
+	struct ThreadTally
+	{
+		std::array<std::uint64_t, sNumCounters> theCounts{};
+
+		//! Add counts to the shared totals (and restart from zero).
+		inline
+		void
+		flush
+			()
+		{
+			for (std::size_t nn{0u} ; nn < sNumCounters ; ++nn)
+			{
+				if (0u < theCounts[nn])
+				{
+					totals().theCounts[nn]
+						.fetch_add(theCounts[nn], std::memory_order_relaxed);
+					theCounts[nn] = 0u;
+				}
+			}
+		}
+
+		//! Flush any remaining counts when thread ends.
+		inline
+		~ThreadTally
+			()
+		{
+			flush();
+		}
+
+	}; // ThreadTally
+
+	//! The tally for the calling thread.
+	inline
+	ThreadTally &
+	threadTally
+		()
+	{
+		thread_local ThreadTally sTally;
+		return sTally;
+	}
+
+	//! Add num events to counter (in tally of the calling thread).
+	inline
+	void
+	count
+		( Counter const & counter
+		, std::uint64_t const & num = 1u
+		)
+	{
+		threadTally().theCounts[static_cast<std::size_t>(counter)] += num;
+	}
+
+	/*! \brief Accumulate (exclusive) time spent in scope to a stage.
+	 *
+	 * Timers may be nested (on each thread). While an inner timer is
+	 * active, time is attributed only to the inner timer's stage, such
+	 * that the stage times do not overlap (on any one thread).
+	 */
+	struct StageTimer
+	{
+		Stage const theStage;
+		StageTimer * const thePtOuter;
+		Clock::time_point theMark;
+
+		//! Innermost timer active on this thread (or null).
+		inline
+		static
+		StageTimer * &
+		active
+			()
+		{
+			thread_local StageTimer * sPtActive{ nullptr };
+			return sPtActive;
+		}
+
+		//! Add time since theMark (to stage) and update mark to now.
+		inline
+		void
+		accumulate
+			( Clock::time_point const & now
+			)
+		{
+			std::chrono::nanoseconds const elapsed
+				{ std::chrono::duration_cast<std::chrono::nanoseconds>
+					(now - theMark)
+				};
+			totals().theStageNanos[static_cast<std::size_t>(theStage)]
+				.fetch_add
+					( static_cast<std::uint64_t>(elapsed.count())
+					, std::memory_order_relaxed
+					);
+			theMark = now;
+		}
+
+		//! Start timing (outer timer, if any, is paused).
+		inline
+		explicit
+		StageTimer
+			( Stage const & stage
+			)
+			: theStage{ stage }
+			, thePtOuter{ active() }
+			, theMark{ Clock::now() }
+		{
+			if (thePtOuter)
+			{
+				thePtOuter->accumulate(theMark);
+			}
+			totals().theStageCalls[static_cast<std::size_t>(theStage)]
+				.fetch_add(1u, std::memory_order_relaxed);
+			active() = this;
+		}
+
+		//! Stop timing (outer timer, if any, is resumed).
+		inline
+		~StageTimer
+			()
+		{
+			Clock::time_point const now{ Clock::now() };
+			accumulate(now);
+			threadTally().flush();
+			if (thePtOuter)
+			{
+				thePtOuter->theMark = now;
+			}
+			active() = thePtOuter;
+		}
+
+		StageTimer(StageTimer const &) = delete;
+		StageTimer & operator=(StageTimer const &) = delete;
+
+	}; // StageTimer
+
+	//! Set all accumulators to zero (and restart wall clock).
+	//! (Counts not yet flushed by other running threads are kept).
+	inline
+	void
+	reset
+		()
+	{
+		Totals & tots = totals();
+		for (std::size_t nn{0u} ; nn < sNumStages ; ++nn)
+		{
+			tots.theStageNanos[nn] = 0u;
+			tots.theStageCalls[nn] = 0u;
+		}
+		for (std::size_t nn{0u} ; nn < sNumCounters ; ++nn)
+		{
+			tots.theCounts[nn] = 0u;
+		}
+		threadTally().theCounts.fill(0u);
+		tots.theStartTicks = Clock::now().time_since_epoch().count();
+	}
+
+	inline
+	Snapshot
+	Snapshot :: current
+		()
+	{
+		threadTally().flush();
+		Snapshot snap;
+		Totals const & tots = totals();
+		for (std::size_t nn{0u} ; nn < sNumStages ; ++nn)
+		{
+			snap.theStageSeconds[nn] = 1.e-9
+				* static_cast<double>(tots.theStageNanos[nn].load());
+			snap.theStageCalls[nn] = tots.theStageCalls[nn].load();
+		}
+		for (std::size_t nn{0u} ; nn < sNumCounters ; ++nn)
+		{
+			snap.theCounts[nn] = tots.theCounts[nn].load();
+		}
+		Clock::duration const wall
+			{ Clock::now().time_since_epoch()
+			- Clock::duration(tots.theStartTicks.load())
+			};
+		snap.theWallSeconds
+			= std::chrono::duration<double>(wall).count();
+		return snap;
+	}
+
+#else // (! OriMania_Profile_Enable)
+
+	//! No-op (instrumentation disabled).
+	inline
+	void
+	count
+		( Counter const &
+		, std::uint64_t const & = 1u
+		)
+	{ }
+
+	//! No-op (instrumentation disabled).
+	struct StageTimer
+	{
+		inline
+		explicit
+		StageTimer
+			( Stage const &
+			)
+		{ }
+
+	}; // StageTimer
+
+	//! No-op (instrumentation disabled).
+	inline
+	void
+	reset
+		()
+	{ }
+
+	inline
+	Snapshot
+	Snapshot :: current
+		()
+	{
+		return Snapshot{};
+	}
+
+#endif // OriMania_Profile_Enable
+
+} // [prof]
+
+} // [om]
+
+
+#endif // OriMania_Profile_INCL_
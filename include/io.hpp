@@ -42,10 +42,12 @@ Example:
 #include "Orientation.hpp"
 #include "ParmGroup.hpp"
 
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <set>
 #include <sstream>
+#include <string_view>
 
 
 namespace om
@@ -82,7 +84,19 @@ namespace om
 	loadIndEOs
 		( std::istream & istrm
 		);
-	
+
+	//! Orientation results (as above) from EO ascii text.
+	std::map<SenKey, SenOri>
+	loadIndEOs
+		( std::string_view const & text
+		);
+
+	//! Orientation results (as above) from (memory mapped) file at path.
+	std::map<SenKey, SenOri>
+	loadIndEOsFile
+		( std::filesystem::path const & path
+		);
+
 	/*! \brief ParmGroup data values loaded from ascii data stream.
 	 *
 	 * Example file content and use:
@@ -93,6 +107,18 @@ namespace om
 		( std::istream & istrm
 		);
 
+	//! ParmGroup data values (as above) from ascii text.
+	std::map<SenKey, ParmGroup>
+	loadParmGroups
+		( std::string_view const & text
+		);
+
+	//! ParmGroup data values (as above) from (memory mapped) file at path.
+	std::map<SenKey, ParmGroup>
+	loadParmGroupsFile
+		( std::filesystem::path const & path
+		);
+
 //
 // Descriptive strings for various items
 //
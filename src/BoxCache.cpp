@@ -0,0 +1,446 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Implementation code for OriMania BoxCache (file cache of Box ROs).
+
+File layout (all values are 8 bytes, native byte order):
+ - Header: magic, key, numConventions, numClasses, numSen, numPairs
+ - Pair slots: numPairs values of (ndx1*numSen + ndx2)
+ - Class indices: numConventions values (ConventionClasses::theClassNdxs)
+ - Representatives: numClasses values (ConventionClasses::theRepNdxs)
+ - Box ROs: for each pair slot, 7 arrays of numClasses doubles
+   (scalar, bivector[0,1,2], location[0,1,2] parts of OriBatch)
+*/
+
+
+#include "BoxCache.hpp"
+
+#include "FileBytes.hpp"
+#include "OriMania.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	define OriMania_BoxCache_UseMkstemp
+#	include <stdlib.h>
+#	include <unistd.h>
+#endif
+
+
+namespace
+{
+	//! File type identifier (also changes if file layout changes)
+	constexpr std::uint64_t sMagic{ 0x314f52786f424d4fu }; // "OMBoxRO1"
+
+	//! Number of header values
+	constexpr std::size_t sNumHead{ 6u };
+
+	//! Version of the table computation (change if RO arithmetic or
+	//! class formation changes - such that older caches are not used)
+	constexpr std::uint64_t sTableVersion{ 2u };
+
+	//! Incremental FNV-1a (64 bit) hash of byte sequences.
+	struct Hasher
+	{
+		std::uint64_t theHash{ 0xcbf29ce484222325u };
+
+		//! Include numBytes starting at ptBytes into hash.
+		inline
+		void
+		add
+			( void const * const & ptBytes
+			, std::size_t const & numBytes
+			)
+		{
+			unsigned char const * const ptBeg
+				{ static_cast<unsigned char const *>(ptBytes) };
+			for (std::size_t nn{0u} ; nn < numBytes ; ++nn)
+			{
+				theHash ^= static_cast<std::uint64_t>(ptBeg[nn]);
+				theHash *= 0x100000001b3u;
+			}
+		}
+
+		//! Include (length and characters of) string into hash.
+		inline
+		void
+		add
+			( std::string const & str
+			)
+		{
+			std::uint64_t const size{ str.size() };
+			add(&size, sizeof(size));
+			add(str.data(), str.size());
+		}
+
+		//! Include (bit pattern of) value into hash.
+		inline
+		void
+		add
+			( double const & value
+			)
+		{
+			add(&value, sizeof(value));
+		}
+
+	}; // Hasher
+
+	//! Sequential copying of arrays out of FileBytes content.
+	struct Reader
+	{
+		om::FileBytes const & theBytes;
+		std::size_t theOffset{ 0u };
+
+		//! True if numBytes more are available
+		inline
+		bool
+		hasBytes
+			( std::size_t const & numBytes
+			) const
+		{
+			return (! (theBytes.theSize < (theOffset + numBytes)));
+		}
+
+		//! Copy numValues (if available) into ptValues. True on success.
+		template <typename Type>
+		inline
+		bool
+		copyInto
+			( Type * const & ptValues
+			, std::size_t const & numValues
+			)
+		{
+			std::size_t const numBytes{ numValues * sizeof(Type) };
+			bool const okay{ hasBytes(numBytes) };
+			if (okay && (0u < numBytes))
+			{
+				std::memcpy(ptValues, theBytes.theBeg + theOffset, numBytes);
+				theOffset += numBytes;
+			}
+			return okay;
+		}
+
+		//! Copy numValues (if available) into vec (as size_t values)
+		inline
+		bool
+		copyInto
+			( std::vector<std::size_t> * const & ptVec
+			, std::size_t const & numValues
+			)
+		{
+			std::vector<std::uint64_t> values(numValues);
+			bool const okay{ copyInto(values.data(), numValues) };
+			if (okay)
+			{
+				ptVec->assign(values.cbegin(), values.cend());
+			}
+			return okay;
+		}
+
+	}; // Reader
+
+	//! Write numValues starting at ptValues to stream.
+	template <typename Type>
+	inline
+	void
+	writeTo
+		( std::ostream & ostrm
+		, Type const * const & ptValues
+		, std::size_t const & numValues
+		)
+	{
+		ostrm.write
+			( reinterpret_cast<char const *>(ptValues)
+			, static_cast<std::streamsize>(numValues * sizeof(Type))
+			);
+	}
+
+	//! Write size_t values (as fixed size) to stream.
+	inline
+	void
+	writeTo
+		( std::ostream & ostrm
+		, std::vector<std::size_t> const & ndxs
+		)
+	{
+		std::vector<std::uint64_t> const values(ndxs.cbegin(), ndxs.cend());
+		writeTo(ostrm, values.data(), values.size());
+	}
+
+	/*! \brief Path of a newly created (empty) file next to filePath.
+	 *
+	 * The name is unique (e.g. among concurrent processes and threads
+	 * saving the same file) and is in the same directory as filePath
+	 * so that it can be renamed to filePath. Empty on failure.
+	 */
+	inline
+	std::string
+	uniqueTempPathFor
+		( std::string const & filePath
+		)
+	{
+		std::string tmpPath;
+#if defined(OriMania_BoxCache_UseMkstemp)
+		std::string pattern{ filePath + ".tmp.XXXXXX" };
+		int const fd{ ::mkstemp(pattern.data()) };
+		if (! (fd < 0))
+		{
+			::close(fd);
+			tmpPath = pattern;
+		}
+#else
+		std::random_device rand;
+		std::size_t attempt{ 0u };
+		while (tmpPath.empty() && (attempt++ < 16u))
+		{
+			std::ostringstream oss;
+			oss << filePath << ".tmp." << std::hex << rand() << rand();
+			std::string const path{ oss.str() };
+			// (not atomic, but random names make collisions unlikely)
+			if (! std::ifstream(path).good())
+			{
+				if (std::ofstream(path, std::ios::binary).good())
+				{
+					tmpPath = path;
+				}
+			}
+		}
+#endif
+		return tmpPath;
+	}
+
+} // [anon]
+
+
+namespace om
+{
+
+std::uint64_t
+boxCacheKeyFor
+	( SenRegistry const & registry
+	, std::map<SenKey, ParmGroup> const & keyBoxPGs
+	, std::size_t const & numConventions
+	)
+{
+	Hasher hasher;
+	hasher.add(projectVersion());
+	hasher.add(&sTableVersion, sizeof(sTableVersion));
+	std::uint64_t const numCons{ numConventions };
+	hasher.add(&numCons, sizeof(numCons));
+	for (SenKey const & key : registry.theKeys)
+	{
+		hasher.add(key);
+	}
+	for (std::map<SenKey, ParmGroup>::value_type const & keyPG : keyBoxPGs)
+	{
+		hasher.add(keyPG.first);
+		for (double const & dist : keyPG.second.theDistances)
+		{
+			hasher.add(dist);
+		}
+		for (double const & angle : keyPG.second.theAngles)
+		{
+			hasher.add(angle);
+		}
+	}
+	return hasher.theHash;
+}
+
+bool
+saveBoxTable
+	( std::string const & cachePath
+	, BoxRelOriTable const & boxTable
+	, std::uint64_t const & cacheKey
+	)
+{
+	std::size_t const numSen{ boxTable.theRegistry.size() };
+	std::size_t const numClasses{ boxTable.theClasses.numClasses() };
+	std::vector<std::size_t> pairSlots;
+	for (std::size_t slot{0u} ; slot < boxTable.thePairBoxROs.size() ; ++slot)
+	{
+		if (! boxTable.thePairBoxROs[slot].empty())
+		{
+			pairSlots.emplace_back(slot);
+		}
+	}
+
+	std::string const tmpPath{ uniqueTempPathFor(cachePath) };
+	bool okay{ false };
+	if (! tmpPath.empty())
+	{
+		std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+		std::array<std::uint64_t, sNumHead> const head
+			{ sMagic
+			, cacheKey
+			, boxTable.theNumConventions
+			, numClasses
+			, numSen
+			, pairSlots.size()
+			};
+		writeTo(ofs, head.data(), head.size());
+		writeTo(ofs, pairSlots);
+		writeTo(ofs, boxTable.theClasses.theClassNdxs);
+		writeTo(ofs, boxTable.theClasses.theRepNdxs);
+		for (std::size_t const & slot : pairSlots)
+		{
+			OriBatch const & batch = boxTable.thePairBoxROs[slot];
+			writeTo(ofs, batch.theScas.data(), numClasses);
+			for (std::vector<double> const & biv : batch.theBivs)
+			{
+				writeTo(ofs, biv.data(), numClasses);
+			}
+			for (std::vector<double> const & loc : batch.theLocs)
+			{
+				writeTo(ofs, loc.data(), numClasses);
+			}
+		}
+		ofs.flush();
+		okay = ofs.good();
+	}
+	if (okay)
+	{
+		okay = (0 == std::rename(tmpPath.c_str(), cachePath.c_str()));
+	}
+	if ((! okay) && (! tmpPath.empty()))
+	{
+		std::remove(tmpPath.c_str());
+	}
+	return okay;
+}
+
+BoxRelOriTable
+loadBoxTable
+	( std::string const & cachePath
+	, SenRegistry const & registry
+	, std::uint64_t const & cacheKey
+	)
+{
+	BoxRelOriTable table;
+
+	FileBytes const bytes(cachePath);
+	Reader reader{ bytes };
+	std::array<std::uint64_t, sNumHead> head{};
+	bool okay
+		{  reader.copyInto(head.data(), head.size())
+		&& (sMagic == head[0])
+		&& (cacheKey == head[1])
+		&& (registry.size() == head[4])
+		};
+	if (okay)
+	{
+		std::size_t const numCons{ head[2] };
+		std::size_t const numClasses{ head[3] };
+		std::size_t const numSen{ head[4] };
+		std::size_t const numPairs{ head[5] };
+
+		std::vector<std::size_t> pairSlots;
+		BoxRelOriTable tmp;
+		tmp.theNumConventions = numCons;
+		tmp.theRegistry = registry;
+		okay =  reader.copyInto(&pairSlots, numPairs)
+			&& reader.copyInto(&(tmp.theClasses.theClassNdxs), numCons)
+			&& reader.copyInto(&(tmp.theClasses.theRepNdxs), numClasses)
+			&& reader.hasBytes(7u * numPairs * numClasses * sizeof(double));
+
+		// class and representative indices must be consistent
+		std::vector<std::size_t> const & classNdxs
+			= tmp.theClasses.theClassNdxs;
+		std::vector<std::size_t> const & repNdxs = tmp.theClasses.theRepNdxs;
+		for (std::size_t cNdx{0u} ; okay && (cNdx < classNdxs.size()) ; ++cNdx)
+		{
+			okay = (classNdxs[cNdx] < numClasses);
+		}
+		for (std::size_t kNdx{0u} ; okay && (kNdx < repNdxs.size()) ; ++kNdx)
+		{
+			okay =  (repNdxs[kNdx] < numCons)
+				&& (kNdx == classNdxs[repNdxs[kNdx]]);
+		}
+
+		if (okay)
+		{
+			tmp.thePairBoxROs.resize(numSen * numSen);
+			for (std::size_t const & slot : pairSlots)
+			{
+				okay = okay && (slot < tmp.thePairBoxROs.size());
+				if (okay)
+				{
+					OriBatch & batch = tmp.thePairBoxROs[slot];
+					batch.resize(numClasses);
+					reader.copyInto(batch.theScas.data(), numClasses);
+					for (std::vector<double> & biv : batch.theBivs)
+					{
+						reader.copyInto(biv.data(), numClasses);
+					}
+					for (std::vector<double> & loc : batch.theLocs)
+					{
+						reader.copyInto(loc.data(), numClasses);
+					}
+				}
+			}
+		}
+		if (okay)
+		{
+			table = std::move(tmp);
+		}
+	}
+
+	return table;
+}
+
+BoxRelOriTable
+cachedBoxTable
+	( std::string const & cachePath
+	, SenRegistry const & registry
+	, std::map<SenKey, ParmGroup> const & keyBoxPGs
+	, std::vector<Convention> const & allCons
+	, bool * const & ptFromCache
+	)
+{
+	std::uint64_t const cacheKey
+		{ boxCacheKeyFor(registry, keyBoxPGs, allCons.size()) };
+	BoxRelOriTable table{ loadBoxTable(cachePath, registry, cacheKey) };
+	bool const fromCache{ (0u < table.theNumConventions) };
+	if (! fromCache)
+	{
+		table = BoxRelOriTable::from
+			(registry, attitudeTablesFor(registry, keyBoxPGs), allCons);
+		saveBoxTable(cachePath, table, cacheKey);
+	}
+	if (ptFromCache)
+	{
+		*ptFromCache = fromCache;
+	}
+	return table;
+}
+
+} // [om]
+
@@ -29,109 +29,145 @@
 
 #include "Convention.hpp"
 
+#include "Profile.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
 
 namespace
 {
+	//! Type for the table of all (valid) conventions
+	using ConventionTable
+		= std::array<om::Convention, om::Convention::theNumConventions>;
+
+	//! Table of all conventions in order of their ConventionId values.
+	constexpr
+	ConventionTable
+	conventionTable
+		()
+	{
+		ConventionTable table{};
+		for (std::size_t nn{0u} ; nn < table.size() ; ++nn)
+		{
+			table[nn] = om::conventionFor(static_cast<om::ConventionId>(nn));
+		}
+		return table;
+	}
 
-//
-// Numeric encodings
-//
+	//! All conventions - generated at compile time (no startup cost).
+	constexpr ConventionTable sAllConventions{ conventionTable() };
+
+	//! Number of table entries for each ConventionOffset value.
+	constexpr std::size_t sNumPerOffset
+		{ om::Convention::theNumConventions
+		/ om::ConventionOffset::theNumConventions
+		};
 
-	//! Convert transform order to numeric values (e.g. for sorting) [0,1]
+	//! True if chr is white space (as for std::isspace() in "C" locale)
 	inline
-	std::int64_t
-	numberFor
-		( om::OrderTR const & order
+	bool
+	isSpace
+		( char const & chr
 		)
 	{
-		return static_cast<std::int64_t>(order);
+		return
+			(  (' ' == chr) || ('\t' == chr) || ('\n' == chr)
+			|| ('\v' == chr) || ('\f' == chr) || ('\r' == chr)
+			);
 	}
 
-	//! Convert sign collection to numeric values (e.g. for sorting) [0,7]
+	//! Digit character for value (or '?' if not in range [0,9])
 	inline
-	std::int64_t
-	numberFor
-		( om::ThreeSigns const & signs
+	char
+	digitFor
+		( int const & value
 		)
 	{
-		return
-			( 4u * (static_cast<std::int64_t>(1u + signs[0]) / 2u)
-			+ 2u * (static_cast<std::int64_t>(1u + signs[1]) / 2u)
-			+ 1u * (static_cast<std::int64_t>(1u + signs[2]) / 2u)
-			);
+		char digit{ '?' };
+		if ((! (value < 0)) && (value < 10))
+		{
+			digit = static_cast<char>('0' + value);
+		}
+		return digit;
 	}
 
-	//! Convert index collection to numeric values (e.g. for sorting) [0,26]
+	//! Put '+'/'-' characters for signs at *ptPtChar (which is advanced)
 	inline
-	std::int64_t
-	numberFor
-		( om::ThreeIndices const & indices
+	void
+	putSigns
+		( char * * const & ptPtChar
+		, om::ThreeSigns const & signs
 		)
 	{
-		return
-			( 9u * static_cast<std::int64_t>(indices[0])
-			+ 3u * static_cast<std::int64_t>(indices[1])
-			+ 1u * static_cast<std::int64_t>(indices[2])
-			);
+		for (std::int8_t const & sign : signs)
+		{
+			*(*ptPtChar)++ = (sign < 0) ? '-' : '+';
+		}
 	}
 
-	//! ThreeSign (int8_t) values for numeric Id
+	//! Put digit characters for ndxs at *ptPtChar (which is advanced)
 	inline
-	om::ThreeSigns
-	threeSignsFor
-		( std::int64_t const numId
+	void
+	putIndices
+		( char * * const & ptPtChar
+		, om::ThreeIndices const & ndxs
 		)
 	{
-		constexpr std::array<om::ThreeSigns, 8u> asInts
-			{ om::ThreeSigns{ -1, -1, -1 }
-			, om::ThreeSigns{ -1, -1,  1 }
-			, om::ThreeSigns{ -1,  1, -1 }
-			, om::ThreeSigns{ -1,  1,  1 }
-			, om::ThreeSigns{  1, -1, -1 }
-			, om::ThreeSigns{  1, -1,  1 }
-			, om::ThreeSigns{  1,  1, -1 }
-			, om::ThreeSigns{  1,  1,  1 }
-			};
-		return asInts[numId];
+		for (std::uint8_t const & ndx : ndxs)
+		{
+			*(*ptPtChar)++ = digitFor(static_cast<int>(ndx));
+		}
 	}
 
-	//! ThreeIndices (int8_t) values for numeric Id
+	//! Signs from '+'/'-' characters at ptChars (0 for other characters)
 	inline
-	om::ThreeIndices
-	threeIndicesFor
-		( std::int64_t const numId
+	om::ThreeSigns
+	signsAt
+		( char const * const & ptChars
 		)
 	{
-		using TI = om::ThreeIndices;
-		constexpr std::array<om::ThreeIndices, 27u> asInts
-			{ TI{  0,  0,  0 }, TI{  0,  0,  1 }, TI{  0,  0,  2 }
-			, TI{  0,  1,  0 }, TI{  0,  1,  1 }, TI{  0,  1,  2 }
-			, TI{  0,  2,  0 }, TI{  0,  2,  1 }, TI{  0,  2,  2 }
-			, TI{  1,  0,  0 }, TI{  1,  0,  1 }, TI{  1,  0,  2 }
-			, TI{  1,  1,  0 }, TI{  1,  1,  1 }, TI{  1,  1,  2 }
-			, TI{  1,  2,  0 }, TI{  1,  2,  1 }, TI{  1,  2,  2 }
-			, TI{  2,  0,  0 }, TI{  2,  0,  1 }, TI{  2,  0,  2 }
-			, TI{  2,  1,  0 }, TI{  2,  1,  1 }, TI{  2,  1,  2 }
-			, TI{  2,  2,  0 }, TI{  2,  2,  1 }, TI{  2,  2,  2 }
-			};
-		return asInts[numId];
+		om::ThreeSigns signs{ 0, 0, 0 };
+		for (std::size_t nn{0u} ; nn < 3u ; ++nn)
+		{
+			if ('-' == ptChars[nn])
+			{
+				signs[nn] = -1;
+			}
+			else
+			if ('+' == ptChars[nn])
+			{
+				signs[nn] = 1;
+			}
+		}
+		return signs;
 	}
 
-	//! OrderTR (enum) values for numeric Id
+	//! Value of digit character at ptChar (255 if not a digit)
 	inline
-	om::OrderTR
-	orderFor
-		( std::int64_t const numId
+	std::uint8_t
+	digitAt
+		( char const * const & ptChar
 		)
 	{
-		constexpr std::array<om::OrderTR, 3u> orders
-			{ om::TranRot
-			, om::RotTran
-			, om::Unknown
-			};
-		return orders[numId];
+		std::uint8_t value{ 255u };
+		// (value is unchanged if not a digit)
+		std::from_chars(ptChar, ptChar + 1u, value);
+		return value;
 	}
 
+	//! Index values from digit characters at ptChars (ref digitAt())
+	inline
+	om::ThreeIndices
+	indicesAt
+		( char const * const & ptChars
+		)
+	{
+		return om::ThreeIndices
+			{ digitAt(ptChars), digitAt(ptChars + 1u), digitAt(ptChars + 2u) };
+	}
 
 } // [anon]
 
@@ -151,26 +187,23 @@ ConventionOffset :: allConventions
 	()
 {
 	std::vector<ConventionOffset> conventions;
-	conventions.reserve(48u);
+	conventions.reserve(ConventionOffset::theNumConventions);
 
-	// all combinations of each characteristic
-	std::array<ThreeSigns, 8u> const locSigns{ allThreeSigns() };
-	std::array<ThreeIndices, 6u> const locNdxs{ allThreeIndices() };
-
-	// brute force generation of all possible combinations
-	for (ThreeSigns const & locSign : locSigns)
+	// offset convention is outer-most (slowest changing) in table
+	for (std::size_t nn{0u} ; nn < sAllConventions.size() ; nn += sNumPerOffset)
 	{
-		for (ThreeIndices const & locNdx : locNdxs)
-		{
-			ConventionOffset const convention
-				{ locSign
-				, locNdx
-				};
-			conventions.emplace_back(convention);
-		}
+		conventions.emplace_back(sAllConventions[nn].theConvOff);
 	}
 	return conventions;
 }
+
+std::size_t
+ConventionOffset :: indexValue
+	() const
+{
+	return offsetIndexFor(*this);
+}
+
 //
 //==========================================================================
 // ConventionAngle
@@ -183,32 +216,23 @@ ConventionAngle :: allConventions
 	()
 {
 	std::vector<ConventionAngle> conventions;
-	conventions.reserve(576u);
-
-	// all combinations of each characteristic
-	std::array<ThreeSigns, 8u> const attSigns{ allThreeSigns() };
-	std::array<ThreeIndices, 6u> const attNdxs{ allThreeIndices() };
-	std::array<ThreeIndices, 12u> const bivNdxs{ allBivIndices() };
+	conventions.reserve(ConventionAngle::theNumConventions);
 
-	// brute force generation of all possible combinations
-	for (ThreeSigns const & attSign : attSigns)
+	// angle conventions (with both orders) follow first offset convention
+	for (std::size_t nn{0u} ; nn < sNumPerOffset ; nn += 2u)
 	{
-		for (ThreeIndices const & attNdx : attNdxs)
-		{
-			for (ThreeIndices const & bivNdx : bivNdxs)
-			{
-				ConventionAngle const convention
-					{ attSign
-					, attNdx
-					, bivNdx
-					};
-				conventions.emplace_back(convention);
-			}
-		}
+		conventions.emplace_back(sAllConventions[nn].theConvAng);
 	}
 	return conventions;
 }
 
+std::size_t
+ConventionAngle :: indexValue
+	() const
+{
+	return angleIndexFor(*this);
+}
+
 //
 //==========================================================================
 // Convention
@@ -221,19 +245,14 @@ Convention :: allConventionsFor
 	( ConventionOffset const & offConv
 	)
 {
-	std::vector<Convention> conventions;
-	std::vector<ConventionAngle>
-		const angConvs{ ConventionAngle::allConventions() };
-	std::array<OrderTR, 2u>
-		const orders{ allOrderTRs() };
-
-	for (ConventionAngle const & angConv : angConvs)
+	// entries for first offset convention span all angles and orders
+	std::vector<Convention> conventions
+		( sAllConventions.cbegin()
+		, sAllConventions.cbegin() + sNumPerOffset
+		);
+	for (Convention & convention : conventions)
 	{
-		for (OrderTR const & order : orders)
-		{
-			Convention const convention{ offConv, angConv, order };
-			conventions.emplace_back(convention);
-		}
+		convention.theConvOff = offConv;
 	}
 	return conventions;
 }
@@ -243,37 +262,35 @@ std::vector<Convention>
 Convention :: allConventions
 	()
 {
-	std::vector<Convention> conventions;
-	conventions.reserve(55296);
-
-	std::vector<ConventionOffset>
-		const offConvs{ ConventionOffset::allConventions() };
-
-	for (ConventionOffset const & offConv : offConvs)
-	{
-		std::vector<Convention> const offConvs
-			{ allConventionsFor(offConv) };
-		conventions.insert
-			( conventions.end()
-			, offConvs.begin(), offConvs.end()
-			);
-	}
-
-	return conventions;
+	return std::vector<Convention>
+		(sAllConventions.cbegin(), sAllConventions.cend());
 }
 
-namespace
+// static
+std::array<Convention, Convention::theNumConventions> const &
+Convention :: allConventionTable
+	()
 {
-	constexpr std::int64_t numIdBase{ 100 }; // for easy human interpretation
-	constexpr std::int64_t numPad   { 1000000000000 };
-	constexpr std::int64_t numOffSgn{   10000000000 };
-	constexpr std::int64_t numOffNdx{     100000000 };
-	constexpr std::int64_t numAngSgn{       1000000 };
-	constexpr std::int64_t numAngNdx{         10000 };
-	constexpr std::int64_t numBivNdx{           100 };
-	constexpr std::int64_t numOrder {             1 };
+	return sAllConventions;
+}
 
-} // [anon]
+// static
+std::size_t
+Convention :: indexValueFor
+	( std::size_t const & offsetIndexValue
+	, std::size_t const & angleIndexValue
+	, OrderTR const & order
+	)
+{
+	// same order as the (nested) loops in allConventions()
+	std::size_t const ndxOrder{ static_cast<std::size_t>(order) };
+	return
+		( ( offsetIndexValue * ConventionAngle::theNumConventions
+		  + angleIndexValue
+		  ) * 2u
+		+ ndxOrder
+		);
+}
 
 // static
 Convention
@@ -281,58 +298,21 @@ Convention :: fromNumberEncoding
 	( std::int64_t const & numId
 	)
 {
-	std::int64_t curr{ numId };
-
-	std::int64_t digOrder{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	std::int64_t digBivNdx{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	std::int64_t digAngNdx{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	std::int64_t digAngSgn{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	std::int64_t digOffNdx{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	std::int64_t digOffSgn{ curr % numIdBase };
-	curr = curr / numIdBase;
-
-	// should be 1
-	// std::int64_t digPad{ curr % numIdBase };
-	// curr = curr / numIdBase;
-
-	return Convention
-		{ ThreeSigns{ threeSignsFor(digOffSgn) }
-		, ThreeIndices{ threeIndicesFor(digOffNdx) }
-		, ThreeSigns{ threeSignsFor(digAngSgn) }
-		, ThreeIndices{ threeIndicesFor(digAngNdx) }
-		, ThreeIndices{ threeIndicesFor(digBivNdx) }
-		, OrderTR{ orderFor(digOrder) }
-		};
+	return conventionFor(conventionIdFromNumberEncoding(numId));
 }
 
 std::int64_t
 Convention :: numberEncoding
 	() const
 {
-	std::int64_t numId{ -1 };;
-	if (isValid())
-	{
-		numId = 
-			( numPad       // so that all values show same width
-			+ numOffSgn  * numberFor(theConvOff.theOffSigns) // 8
-			+ numOffNdx  * numberFor(theConvOff.theOffIndices) // <32
-			+ numAngSgn  * numberFor(theConvAng.theAngSigns) // 8
-			+ numAngNdx  * numberFor(theConvAng.theAngIndices) // <32
-			+ numBivNdx  * numberFor(theConvAng.theBivIndices) // <32
-			+ numOrder   * numberFor(theOrder) // 2
-			);
-	}
-	return numId;
+	return numberEncodingFor(conventionIdFor(*this));
+}
+
+std::size_t
+Convention :: indexValue
+	() const
+{
+	return static_cast<std::size_t>(conventionIdFor(*this));
 }
 
 bool
@@ -389,6 +369,17 @@ Convention :: transformFor
 	( ParmGroup const & parmGroup
 	) const
 {
+	return transformFor(parmGroup, attitudeFor(parmGroup));
+}
+
+rigibra::Transform
+Convention :: transformFor
+	( ParmGroup const & parmGroup
+	, rigibra::Attitude const & attR
+	) const
+{
+	prof::count(prof::Counter::TransformFor);
+
 	std::array<double, 3u> const & dVals = parmGroup.theDistances;
 
 	using namespace engabra::g3;
@@ -400,9 +391,6 @@ Convention :: transformFor
 		, theConvOff.theOffSigns[2] * dVals[theConvOff.theOffIndices[2]]
 		};
 
-	// determine attitude associated with parmGroup
-	rigibra::Attitude const attR(attitudeFor(parmGroup));
-
 	// to compute translation
 	// first, assume TranRot convention...
 	Vector tVec{ offset };
@@ -438,6 +426,135 @@ Convention :: infoString
 	return oss.str();
 }
 
+//
+//==========================================================================
+// AttitudeTable
+//==========================================================================
+//
+
+// static
+AttitudeTable
+AttitudeTable :: from
+	( ParmGroup const & parmGroup
+	)
+{
+	AttitudeTable table;
+	table.theParmGroup = parmGroup;
+	table.theAtts.reserve(ConventionAngle::theNumConventions);
+
+	// Elementary (single plane) attitudes for each signed angle size.
+	// All 576 attitudes are compositions of these 18. Each is a spinor
+	// (cos(a/2), dir*sin(a/2)*plane) formed from the half-angle cosine
+	// and sine of the three angles - so that trig functions are
+	// evaluated 6 times rather than (3*576) times. The bivector sign
+	// (dir) of the rigibra convention is taken from a reference case.
+	using namespace engabra::g3;
+	static double const sDir
+		{ (rigibra::Attitude(rigibra::PhysAngle{ e23 }).spinor().theBiv[0] < 0.)
+			? -1.
+			: 1.
+		};
+	std::array<double, 3u> const & aVals = parmGroup.theAngles;
+	std::array<double, 3u> halfCoss{};
+	std::array<double, 3u> halfSins{};
+	for (std::size_t nn{0u} ; nn < 3u ; ++nn)
+	{
+		halfCoss[nn] = std::cos(.5 * aVals[nn]);
+		halfSins[nn] = std::sin(.5 * aVals[nn]);
+	}
+	std::vector<rigibra::Attitude> elemAtts;
+	elemAtts.reserve(2u * 3u * 3u);
+	for (double const & sign : { -1., 1. })
+	{
+		for (std::size_t nn{0u} ; nn < 3u ; ++nn)
+		{
+			// planes e23, e31, e12 (ref attitudeFor()) are biv[0,1,2]
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				std::array<double, 3u> biv{ 0., 0., 0. };
+				biv[kk] = sDir * sign * halfSins[nn];
+				elemAtts.emplace_back
+					(rigibra::Attitude
+						(Spinor{ halfCoss[nn], biv[0], biv[1], biv[2] })
+					);
+			}
+		}
+	}
+
+	// Partial products (attB*attA) shared by all angle conventions that
+	// start with the same two elementary rotations (i.e. tree nodes
+	// keyed by first and second rotation). There are 144 of these for
+	// the 576 conventions, so that (144+576) rather than (2*576) attitude
+	// multiplications are needed to complete the table.
+	std::size_t const numElem{ elemAtts.size() };
+	constexpr std::size_t noPrefix{ std::numeric_limits<std::size_t>::max() };
+	std::vector<std::size_t> prefixNdxs(numElem * numElem, noPrefix);
+	std::vector<rigibra::Attitude> prefixAtts;
+	prefixAtts.reserve(numElem * numElem);
+
+	// offset and order conventions do not affect the attitude
+	std::vector<ConventionAngle>
+		const angConvs{ ConventionAngle::allConventions() };
+	for (ConventionAngle const & angConv : angConvs)
+	{
+		// elementary attitudes for each of the three angles
+		std::array<std::size_t, 3u> elemNdxs{};
+		for (std::size_t nn{0u} ; nn < 3u ; ++nn)
+		{
+			std::size_t const ndxSign(0 < angConv.theAngSigns[nn]);
+			elemNdxs[nn] =
+				( (ndxSign * 3u + angConv.theAngIndices[nn]) * 3u
+				+ angConv.theBivIndices[nn]
+				);
+		}
+
+		// partial product of first two rotations (evaluate once)
+		std::size_t & prefixNdx = prefixNdxs[elemNdxs[0]*numElem + elemNdxs[1]];
+		if (noPrefix == prefixNdx)
+		{
+			rigibra::Attitude const & attA = elemAtts[elemNdxs[0]];
+			rigibra::Attitude const & attB = elemAtts[elemNdxs[1]];
+			prefixNdx = prefixAtts.size();
+			prefixAtts.emplace_back(attB * attA);
+		}
+		rigibra::Attitude const & attBA = prefixAtts[prefixNdx];
+		rigibra::Attitude const & attC = elemAtts[elemNdxs[2]];
+
+		// same rotations as Convention::attitudeFor() - but with the
+		// product associated as attC*(attB*attA) such that values may
+		// differ from the direct computation by roundoff.
+		table.theAtts.emplace_back(attC * attBA);
+	}
+
+	return table;
+}
+
+bool
+AttitudeTable :: isValid
+	() const
+{
+	return
+		(  theParmGroup.isValid()
+		&& (ConventionAngle::theNumConventions == theAtts.size())
+		);
+}
+
+rigibra::Attitude const &
+AttitudeTable :: attitudeFor
+	( Convention const & convention
+	) const
+{
+	return theAtts[convention.theConvAng.indexValue()];
+}
+
+rigibra::Transform
+AttitudeTable :: transformFor
+	( Convention const & convention
+	) const
+{
+	return convention.transformFor(theParmGroup, attitudeFor(convention));
+}
+
 //
 //==========================================================================
 // ConventionString
@@ -475,18 +592,37 @@ ConventionString :: from
 // static
 ConventionString
 ConventionString :: from
-	( std::string const & encoding
+	( std::string_view const & encoding
 	)
 {
-	std::istringstream iss(encoding);
-	ConventionString cs;
-	iss
-		>> cs.theStrOffSigns >> cs.theStrOffNdxs
-		>> cs.theStrAngSigns >> cs.theStrAngNdxs
-		>> cs.theStrBivNdxs
-		>> cs.theStrOrder
-		;
-	return cs;
+	// white space separated fields (as for operator>>())
+	std::array<std::string_view, 6u> fields{};
+	std::size_t numFields{ 0u };
+	std::size_t pos{ 0u };
+	while ((numFields < fields.size()) && (pos < encoding.size()))
+	{
+		while ((pos < encoding.size()) && isSpace(encoding[pos]))
+		{
+			++pos;
+		}
+		std::size_t const beg{ pos };
+		while ((pos < encoding.size()) && (! isSpace(encoding[pos])))
+		{
+			++pos;
+		}
+		if (beg < pos)
+		{
+			fields[numFields++] = encoding.substr(beg, pos - beg);
+		}
+	}
+	return ConventionString
+		{ std::string(fields[0])
+		, std::string(fields[1])
+		, std::string(fields[2])
+		, std::string(fields[3])
+		, std::string(fields[4])
+		, std::string(fields[5])
+		};
 }
 
 std::string
@@ -494,16 +630,16 @@ ConventionString :: stringEncoding
 	(
 	) const
 {
-	std::ostringstream oss;
-	oss
-		<< theStrOffSigns
-		<< ' ' << theStrOffNdxs
-		<< ' ' << theStrAngSigns
-		<< ' ' << theStrAngNdxs
-		<< ' ' << theStrBivNdxs
-		<< ' ' << theStrOrder
-		;
-	return oss.str();
+	std::string encoding;
+	encoding.reserve(ConventionText::sNumChars);
+	encoding
+		.append(theStrOffSigns).append(1u, ' ')
+		.append(theStrOffNdxs).append(1u, ' ')
+		.append(theStrAngSigns).append(1u, ' ')
+		.append(theStrAngNdxs).append(1u, ' ')
+		.append(theStrBivNdxs).append(1u, ' ')
+		.append(theStrOrder);
+	return encoding;
 }
 
 bool
@@ -535,6 +671,78 @@ ConventionString :: convention
 		{ locSigns, locNdxs, angSigns, angNdxs, bivNdxs, order };
 }
 
+//
+//==========================================================================
+// ConventionText
+//==========================================================================
+//
+
+// static
+ConventionText
+ConventionText :: from
+	( Convention const & convention
+	)
+{
+	// same field order as ConventionString::from(convention)
+	ConventionText text;
+	char * ptChar{ text.theChars.data() };
+	putSigns(&ptChar, convention.theConvAng.theAngSigns);
+	*ptChar++ = ' ';
+	putIndices(&ptChar, convention.theConvAng.theAngIndices);
+	*ptChar++ = ' ';
+	putSigns(&ptChar, convention.theConvOff.theOffSigns);
+	*ptChar++ = ' ';
+	putIndices(&ptChar, convention.theConvOff.theOffIndices);
+	*ptChar++ = ' ';
+	putIndices(&ptChar, convention.theConvAng.theBivIndices);
+	*ptChar++ = ' ';
+	*ptChar = digitFor(static_cast<int>(convention.theOrder));
+	return text;
+}
+
+// static
+ConventionText
+ConventionText :: from
+	( ConventionId const & convId
+	)
+{
+	return from(conventionFor(convId));
+}
+
+Convention
+ConventionText :: convention
+	() const
+{
+	// fields (in place) in the order written by from(convention)
+	char const * const ptChars{ theChars.data() };
+	OrderTR order{ Unknown };
+	std::uint8_t const orderDigit{ digitAt(ptChars + 20u) };
+	if (0u == orderDigit)
+	{
+		order = TranRot;
+	}
+	else
+	if (1u == orderDigit)
+	{
+		order = RotTran;
+	}
+	return Convention
+		{ signsAt(ptChars + 8u)
+		, indicesAt(ptChars + 12u)
+		, signsAt(ptChars)
+		, indicesAt(ptChars + 4u)
+		, indicesAt(ptChars + 16u)
+		, order
+		};
+}
+
+ConventionId
+ConventionText :: conventionId
+	() const
+{
+	return conventionIdFor(convention());
+}
+
 
 } // [om]
 
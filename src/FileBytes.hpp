@@ -0,0 +1,135 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef OriMania_FileBytes_INCL_
+#define OriMania_FileBytes_INCL_
+
+/*! \file
+\brief Library internal (memory mapped) read access to file content.
+*/
+
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	define OriMania_FileBytes_UseMmap
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+
+namespace om
+{
+	//! Read-only view of an entire file's content.
+	struct FileBytes
+	{
+		unsigned char const * theBeg{ nullptr };
+		std::size_t theSize{ 0u };
+
+#if defined(OriMania_FileBytes_UseMmap)
+		void * theMap{ nullptr };
+#else
+		std::vector<unsigned char> theData{};
+#endif
+
+		//! Content of file at path (empty if not available)
+		inline
+		explicit
+		FileBytes
+			( std::string const & path
+			)
+		{
+#if defined(OriMania_FileBytes_UseMmap)
+			int const fd{ ::open(path.c_str(), O_RDONLY) };
+			if (! (fd < 0))
+			{
+				struct stat info;
+				if ((0 == ::fstat(fd, &info)) && (0 < info.st_size))
+				{
+					std::size_t const size
+						{ static_cast<std::size_t>(info.st_size) };
+					void * const ptMap
+						{ ::mmap
+							(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)
+						};
+					if (! (MAP_FAILED == ptMap))
+					{
+						theMap = ptMap;
+						theBeg = static_cast<unsigned char const *>(ptMap);
+						theSize = size;
+					}
+				}
+				::close(fd);
+			}
+#else
+			std::ifstream ifs(path, std::ios::binary);
+			theData.assign
+				( std::istreambuf_iterator<char>(ifs)
+				, std::istreambuf_iterator<char>()
+				);
+			theBeg = theData.data();
+			theSize = theData.size();
+#endif
+		}
+
+		//! Content as characters (e.g. for text parsing)
+		inline
+		std::string_view
+		view
+			() const
+		{
+			return std::string_view
+				(reinterpret_cast<char const *>(theBeg), theSize);
+		}
+
+		FileBytes(FileBytes const &) = delete;
+		FileBytes & operator=(FileBytes const &) = delete;
+
+		inline
+		~FileBytes
+			()
+		{
+#if defined(OriMania_FileBytes_UseMmap)
+			if (theMap)
+			{
+				::munmap(theMap, theSize);
+			}
+#endif
+		}
+
+	}; // FileBytes
+
+} // [om]
+
+
+#endif // OriMania_FileBytes_INCL_
@@ -0,0 +1,394 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Implementation code for OriMania OriBatch kernels.
+
+NOTE: This file is compiled without floating point contraction (and
+without errno side effects for sqrt) - ref src/CMakeLists.txt. This
+allows loops to be vectorized while producing the same values as the
+single element functions.
+*/
+
+
+#include "OriBatch.hpp"
+
+#include "Profile.hpp"
+
+#include <cmath>
+
+
+// Compile kernels for several instruction sets with runtime dispatch
+#if defined(__GNUC__) && (! defined(__clang__)) && defined(__x86_64__)
+#	define OriMania_TargetClones \
+		__attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#	define OriMania_TargetClones
+#endif
+
+// Kernel loops: array elements are independent (e.g. even if in/out alias)
+#if defined(__clang__)
+#	define OriMania_IndependentLoop \
+		_Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#	define OriMania_IndependentLoop _Pragma("GCC ivdep")
+#else
+#	define OriMania_IndependentLoop
+#endif
+
+
+namespace
+{
+	//! Rotation, R(v), of vector (v0,v1,v2) by spinor (cc, b0,b1,b2).
+	inline
+	void
+	rotate
+		( double const cc
+		, double const b0
+		, double const b1
+		, double const b2
+		, double const v0
+		, double const v1
+		, double const v2
+		, double & r0
+		, double & r1
+		, double & r2
+		)
+	{
+		// b x v
+		double const x0{ b1*v2 - b2*v1 };
+		double const x1{ b2*v0 - b0*v2 };
+		double const x2{ b0*v1 - b1*v0 };
+		// b x (b x v)
+		double const y0{ b1*x2 - b2*x1 };
+		double const y1{ b2*x0 - b0*x2 };
+		double const y2{ b0*x1 - b1*x0 };
+		r0 = v0 - 2.*cc*x0 + 2.*y0;
+		r1 = v1 - 2.*cc*x1 + 2.*y1;
+		r2 = v2 - 2.*cc*x2 + 2.*y2;
+	}
+
+	//! Reverse rotation, inverse(R)(v) (ref rotate()).
+	inline
+	void
+	rotateReverse
+		( double const cc
+		, double const b0
+		, double const b1
+		, double const b2
+		, double const v0
+		, double const v1
+		, double const v2
+		, double & r0
+		, double & r1
+		, double & r2
+		)
+	{
+		rotate(cc, -b0, -b1, -b2, v0, v1, v2, r0, r1, r2);
+	}
+
+	//! Closed form basis RMSE (ref om::rotorTransformRMSE()).
+	inline
+	double
+	rmseFor
+		( double const cc
+		, double const b0
+		, double const b1
+		, double const b2
+		, double const t0
+		, double const t1
+		, double const t2
+		)
+	{
+		double const bSq{ b0*b0 + b1*b1 + b2*b2 };
+		double const tSq{ t0*t0 + t1*t1 + t2*t2 };
+		double const bDotT{ b0*t0 + b1*t1 + b2*t2 };
+		double const sDotB{ b0 + b1 + b2 };
+		double const sDotT{ t0 + t1 + t2 };
+		double const triple // s.(b x t)
+			{ (b1*t2 - b2*t1) + (b2*t0 - b0*t2) + (b0*t1 - b1*t0) };
+
+		double const sumSq
+			{ 8.*bSq + 3.*tSq
+			+ 4.*(sDotB*bDotT - bSq*sDotT - cc*triple)
+			};
+
+		// Statistical degrees of freedom (as om::basisTransformRMSE())
+		constexpr double statDof{ 9. - 6. };
+
+		// sumSq can be slightly negative from roundoff (if near zero).
+		// Clamp to zero without branching, i.e. (.5*(x+|x|)) which is
+		// exactly x for positive x and for which NaN values propagate.
+		double const clampSq{ .5 * (sumSq + std::abs(sumSq)) };
+		double const sse{ (1./statDof) * clampSq };
+		return std::sqrt(sse);
+	}
+
+	/*! \brief Closed form RMSE of relative transform ori2wX * inverse(ori1wX)
+	 *
+	 * The relative transform has spinor (ref rigibra composition)
+	 * \verbatim
+	 *   sca = c2*c1 + b2.b1
+	 *   biv = c1*b2 - c2*b1 + b2 x b1
+	 * \endverbatim
+	 * and location R1(t2 - t1).
+	 */
+	inline
+	double
+	rmseBetween
+		( double const c1
+		, double const b10
+		, double const b11
+		, double const b12
+		, double const t10
+		, double const t11
+		, double const t12
+		, double const c2
+		, double const b20
+		, double const b21
+		, double const b22
+		, double const t20
+		, double const t21
+		, double const t22
+		)
+	{
+		double const cc{ c2*c1 + (b20*b10 + b21*b11 + b22*b12) };
+		double const b0{ (c1*b20 - c2*b10) + (b21*b12 - b22*b11) };
+		double const b1{ (c1*b21 - c2*b11) + (b22*b10 - b20*b12) };
+		double const b2{ (c1*b22 - c2*b12) + (b20*b11 - b21*b10) };
+		double t0, t1, t2;
+		rotate(c1, b10, b11, b12, t20 - t10, t21 - t11, t22 - t12, t0, t1, t2);
+		return rmseFor(cc, b0, b1, b2, t0, t1, t2);
+	}
+
+	//! Kernel: inverse of each orientation (as rigibra::inverse()).
+	OriMania_TargetClones
+	void
+	inverseKernel
+		( om::OriBatch const & oris
+		, om::OriBatch & outOris
+		)
+	{
+		std::size_t const numOris{ outOris.size() };
+		double const * const cs{ oris.theScas.data() };
+		double const * const b0s{ oris.theBivs[0].data() };
+		double const * const b1s{ oris.theBivs[1].data() };
+		double const * const b2s{ oris.theBivs[2].data() };
+		double const * const t0s{ oris.theLocs[0].data() };
+		double const * const t1s{ oris.theLocs[1].data() };
+		double const * const t2s{ oris.theLocs[2].data() };
+		double * const outCs{ outOris.theScas.data() };
+		double * const outB0s{ outOris.theBivs[0].data() };
+		double * const outB1s{ outOris.theBivs[1].data() };
+		double * const outB2s{ outOris.theBivs[2].data() };
+		double * const outT0s{ outOris.theLocs[0].data() };
+		double * const outT1s{ outOris.theLocs[1].data() };
+		double * const outT2s{ outOris.theLocs[2].data() };
+		OriMania_IndependentLoop
+		for (std::size_t nn{0u} ; nn < numOris ; ++nn)
+		{
+			// spinor reverse and location: -R(t)
+			double r0, r1, r2;
+			rotate
+				( cs[nn], b0s[nn], b1s[nn], b2s[nn]
+				, t0s[nn], t1s[nn], t2s[nn]
+				, r0, r1, r2
+				);
+			outCs[nn] = cs[nn];
+			outB0s[nn] = -b0s[nn];
+			outB1s[nn] = -b1s[nn];
+			outB2s[nn] = -b2s[nn];
+			outT0s[nn] = -r0;
+			outT1s[nn] = -r1;
+			outT2s[nn] = -r2;
+		}
+	}
+
+	//! Kernel: composition, x2 * x1, (as rigibra::operator*()).
+	OriMania_TargetClones
+	void
+	composeKernel
+		( om::OriBatch const & oris2
+		, om::OriBatch const & oris1
+		, om::OriBatch & outOris
+		)
+	{
+		std::size_t const numOris{ outOris.size() };
+		double const * const c2s{ oris2.theScas.data() };
+		double const * const b20s{ oris2.theBivs[0].data() };
+		double const * const b21s{ oris2.theBivs[1].data() };
+		double const * const b22s{ oris2.theBivs[2].data() };
+		double const * const t20s{ oris2.theLocs[0].data() };
+		double const * const t21s{ oris2.theLocs[1].data() };
+		double const * const t22s{ oris2.theLocs[2].data() };
+		double const * const c1s{ oris1.theScas.data() };
+		double const * const b10s{ oris1.theBivs[0].data() };
+		double const * const b11s{ oris1.theBivs[1].data() };
+		double const * const b12s{ oris1.theBivs[2].data() };
+		double const * const t10s{ oris1.theLocs[0].data() };
+		double const * const t11s{ oris1.theLocs[1].data() };
+		double const * const t12s{ oris1.theLocs[2].data() };
+		double * const cs{ outOris.theScas.data() };
+		double * const b0s{ outOris.theBivs[0].data() };
+		double * const b1s{ outOris.theBivs[1].data() };
+		double * const b2s{ outOris.theBivs[2].data() };
+		double * const t0s{ outOris.theLocs[0].data() };
+		double * const t1s{ outOris.theLocs[1].data() };
+		double * const t2s{ outOris.theLocs[2].data() };
+		OriMania_IndependentLoop
+		for (std::size_t nn{0u} ; nn < numOris ; ++nn)
+		{
+			double const c2{ c2s[nn] };
+			double const b20{ b20s[nn] };
+			double const b21{ b21s[nn] };
+			double const b22{ b22s[nn] };
+			double const c1{ c1s[nn] };
+			double const b10{ b10s[nn] };
+			double const b11{ b11s[nn] };
+			double const b12{ b12s[nn] };
+			// spinor product
+			cs[nn] = c2*c1 - (b20*b10 + b21*b11 + b22*b12);
+			b0s[nn] = (c2*b10 + c1*b20) - (b21*b12 - b22*b11);
+			b1s[nn] = (c2*b11 + c1*b21) - (b22*b10 - b20*b12);
+			b2s[nn] = (c2*b12 + c1*b22) - (b20*b11 - b21*b10);
+			// location: t1 + inverse(R1)(t2)
+			double r0, r1, r2;
+			rotateReverse
+				(c1, b10, b11, b12, t20s[nn], t21s[nn], t22s[nn], r0, r1, r2);
+			t0s[nn] = t10s[nn] + r0;
+			t1s[nn] = t11s[nn] + r1;
+			t2s[nn] = t12s[nn] + r2;
+		}
+	}
+
+	//! Kernel: add rmseBetween(oris1wX[k], parts2wX) into sums[k].
+	OriMania_TargetClones
+	void
+	addErrorsKernel
+		( double * const sums
+		, om::OriBatch const & oris1wX
+		, om::OriParts const & parts2wX
+		, std::size_t const ndxBeg
+		, std::size_t const ndxEnd
+		)
+	{
+		double const * const c1s{ oris1wX.theScas.data() };
+		double const * const b10s{ oris1wX.theBivs[0].data() };
+		double const * const b11s{ oris1wX.theBivs[1].data() };
+		double const * const b12s{ oris1wX.theBivs[2].data() };
+		double const * const t10s{ oris1wX.theLocs[0].data() };
+		double const * const t11s{ oris1wX.theLocs[1].data() };
+		double const * const t12s{ oris1wX.theLocs[2].data() };
+		double const c2{ parts2wX.theSca };
+		double const b20{ parts2wX.theBiv[0] };
+		double const b21{ parts2wX.theBiv[1] };
+		double const b22{ parts2wX.theBiv[2] };
+		double const t20{ parts2wX.theLoc[0] };
+		double const t21{ parts2wX.theLoc[1] };
+		double const t22{ parts2wX.theLoc[2] };
+		OriMania_IndependentLoop
+		for (std::size_t nn{ndxBeg} ; nn < ndxEnd ; ++nn)
+		{
+			sums[nn] += rmseBetween
+				( c1s[nn], b10s[nn], b11s[nn], b12s[nn]
+				, t10s[nn], t11s[nn], t12s[nn]
+				, c2, b20, b21, b22, t20, t21, t22
+				);
+		}
+	}
+
+} // [anon]
+
+
+namespace om
+{
+
+double
+rmseRotorFor
+	( OriParts const & parts
+	)
+{
+	return rmseFor
+		( parts.theSca, parts.theBiv[0], parts.theBiv[1], parts.theBiv[2]
+		, parts.theLoc[0], parts.theLoc[1], parts.theLoc[2]
+		);
+}
+
+double
+rmseRotorBetween
+	( OriParts const & parts1wX
+	, OriParts const & parts2wX
+	)
+{
+	return rmseBetween
+		( parts1wX.theSca
+		, parts1wX.theBiv[0], parts1wX.theBiv[1], parts1wX.theBiv[2]
+		, parts1wX.theLoc[0], parts1wX.theLoc[1], parts1wX.theLoc[2]
+		, parts2wX.theSca
+		, parts2wX.theBiv[0], parts2wX.theBiv[1], parts2wX.theBiv[2]
+		, parts2wX.theLoc[0], parts2wX.theLoc[1], parts2wX.theLoc[2]
+		);
+}
+
+OriBatch
+inverseOf
+	( OriBatch const & oris
+	)
+{
+	OriBatch invs{ OriBatch::withSize(oris.size()) };
+	inverseKernel(oris, invs);
+	prof::count(prof::Counter::Inverse, oris.size());
+	return invs;
+}
+
+OriBatch
+composedOf
+	( OriBatch const & oris2
+	, OriBatch const & oris1
+	)
+{
+	OriBatch outOris;
+	if (oris2.size() == oris1.size())
+	{
+		outOris.resize(oris1.size());
+		composeKernel(oris2, oris1, outOris);
+	}
+	return outOris;
+}
+
+void
+addRmseRotorErrors
+	( double * const & sums
+	, OriBatch const & oris1wX
+	, OriParts const & parts2wX
+	, std::size_t const & ndxBeg
+	, std::size_t const & ndxEnd
+	)
+{
+	addErrorsKernel(sums, oris1wX, parts2wX, ndxBeg, ndxEnd);
+}
+
+} // [om]
+
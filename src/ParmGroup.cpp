@@ -110,14 +110,12 @@ stringFrom
 	( om::ThreeSigns const & signInts
 	)
 {
-	std::ostringstream oss;
-	//	using ThreeSigns = std::array<std::int8_t, 3u>;
-	oss
-		<< priv::pmCharFor(signInts[0])
-		<< priv::pmCharFor(signInts[1])
-		<< priv::pmCharFor(signInts[2])
-		;
-	return oss.str();
+	// (short strings are stored without heap allocation)
+	return std::string
+		{ priv::pmCharFor(signInts[0])
+		, priv::pmCharFor(signInts[1])
+		, priv::pmCharFor(signInts[2])
+		};
 }
 
 std::string
@@ -125,14 +123,12 @@ stringFrom
 	( ThreeIndices const & ndxInts
 	)
 {
-	std::ostringstream oss;
-	//	using ThreeIndices = std::array<std::uint8_t, 3u>;
-	oss
-		<< static_cast<int>(ndxInts[0])
-		<< static_cast<int>(ndxInts[1])
-		<< static_cast<int>(ndxInts[2])
-		;
-	return oss.str();
+	std::string str;
+	for (std::uint8_t const & ndxInt : ndxInts)
+	{
+		str.append(std::to_string(static_cast<int>(ndxInt)));
+	}
+	return str;
 }
 
 std::string
@@ -140,9 +136,7 @@ stringFrom
 	( OrderTR const & order
 	)
 {
-	std::ostringstream oss;
-	oss << static_cast<int>(order);
-	return oss.str();
+	return std::to_string(static_cast<int>(order));
 }
 
 ThreeSigns
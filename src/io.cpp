@@ -24,11 +24,296 @@
 
 /*! \file
 \brief Implementation code for OriMania io.hpp
+
+The data loaders parse (e.g. memory mapped) text in place via string
+views and std::from_chars(), i.e. without per line stream or string
+construction. The accepted format (and the treatment of bad values) is
+that of the prior stream operator>>() based implementation.
 */
 
 
 #include "io.hpp"
 
+#include "FileBytes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+
+
+namespace
+{
+	/*! \brief True if chr is white space (as for std::isspace() in "C" locale)
+	 *
+	 * Consistent with separation of fields by stream operator>>().
+	 */
+	inline
+	bool
+	isSpace
+		( char const & chr
+		)
+	{
+		return
+			(  (' ' == chr) || ('\t' == chr) || ('\n' == chr)
+			|| ('\v' == chr) || ('\f' == chr) || ('\r' == chr)
+			);
+	}
+
+	//! True if chr is a decimal digit
+	inline
+	bool
+	isDigit
+		( char const & chr
+		)
+	{
+		return (('0' <= chr) && (chr <= '9'));
+	}
+
+	//! True if chr is an exponent indicator
+	inline
+	bool
+	isExpChar
+		( char const & chr
+		)
+	{
+		return (('e' == chr) || ('E' == chr));
+	}
+
+	//! Next line (without newline) from text starting at *ptPos
+	inline
+	std::string_view
+	nextLine
+		( std::string_view const & text
+		, std::size_t * const & ptPos
+		)
+	{
+		std::size_t const beg{ *ptPos };
+		std::size_t end{ text.find('\n', beg) };
+		if (std::string_view::npos == end)
+		{
+			end = text.size();
+			*ptPos = end;
+		}
+		else
+		{
+			*ptPos = end + 1u;
+		}
+		return text.substr(beg, end - beg);
+	}
+
+	//! Active portion of line (as for trimmed(withoutComment(line)))
+	inline
+	std::string_view
+	recordFrom
+		( std::string_view const & line
+		)
+	{
+		std::string_view record{ line.substr(0u, line.find('#')) };
+		std::size_t const posBeg{ record.find_first_not_of(" \t") };
+		if (std::string_view::npos == posBeg)
+		{
+			record = std::string_view{};
+		}
+		else
+		{
+			std::size_t const posLast{ record.find_last_not_of(" \t") };
+			record = record.substr(posBeg, posLast + 1u - posBeg);
+		}
+		return record;
+	}
+
+	//! Next white space delimited field (if any) as for operator>>()
+	inline
+	bool
+	fieldFrom
+		( std::string_view const & record
+		, std::size_t * const & ptPos
+		, std::string_view * const & ptField
+		)
+	{
+		std::size_t pos{ *ptPos };
+		while ((pos < record.size()) && isSpace(record[pos]))
+		{
+			++pos;
+		}
+		std::size_t const beg{ pos };
+		while ((pos < record.size()) && (! isSpace(record[pos])))
+		{
+			++pos;
+		}
+		*ptPos = pos;
+		bool const okay{ (beg < pos) };
+		if (okay)
+		{
+			*ptField = record.substr(beg, pos - beg);
+		}
+		return okay;
+	}
+
+	/*! \brief Next numeric value (if any) as for operator>>(double).
+	 *
+	 * As for stream extraction, if there is no further (non-white)
+	 * content, *ptValue is unchanged. If the content is not a number,
+	 * *ptValue is set to zero. In both cases the return value is false.
+	 */
+	inline
+	bool
+	valueFrom
+		( std::string_view const & record
+		, std::size_t * const & ptPos
+		, double * const & ptValue
+		)
+	{
+		std::size_t pos{ *ptPos };
+		while ((pos < record.size()) && isSpace(record[pos]))
+		{
+			++pos;
+		}
+		bool okay{ false };
+		if (pos < record.size())
+		{
+			// operator>>() allows leading '+' but not "inf" nor "nan"
+			char const * ptBeg{ record.data() + pos };
+			char const * const ptEnd{ record.data() + record.size() };
+			std::size_t numSign{ 0u };
+			if (('+' == *ptBeg) || ('-' == *ptBeg))
+			{
+				numSign = 1u;
+			}
+			char const * const ptMag{ ptBeg + numSign };
+			if ((ptMag < ptEnd) && (isDigit(*ptMag) || ('.' == *ptMag)))
+			{
+				if ('+' == *ptBeg)
+				{
+					ptBeg = ptMag;
+				}
+				std::from_chars_result const result
+					{ std::from_chars(ptBeg, ptEnd, *ptValue) };
+				// operator>>() fails on incomplete exponent (e.g. "1.e")
+				okay =  (std::errc{} == result.ec)
+					&& (! ( (result.ptr < ptEnd)
+						 && isExpChar(*result.ptr)
+						 && (result.ptr == std::find_if
+							(ptBeg, result.ptr, isExpChar))
+						  ));
+				if (okay)
+				{
+					pos = static_cast<std::size_t>(result.ptr - record.data());
+				}
+			}
+			if (! okay)
+			{
+				*ptValue = 0.;
+				pos = record.size();
+			}
+		}
+		*ptPos = pos;
+		return okay;
+	}
+
+	//! Three numeric values (as for operator>>() sequence) from record
+	inline
+	std::array<double, 3u>
+	threeValuesFrom
+		( std::string_view const & record
+		, std::size_t * const & ptPos
+		)
+	{
+		std::array<double, 3u> values
+			{ engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			, engabra::g3::null<double>()
+			};
+		( valueFrom(record, ptPos, &(values[0]))
+		&& valueFrom(record, ptPos, &(values[1]))
+		&& valueFrom(record, ptPos, &(values[2]))
+		);
+		return values;
+	}
+
+	//! Valid records loaded for one sensor.
+	struct KeyRecords
+	{
+		om::Convention theConvention{};
+		om::ThreeDistances theDistances{};
+		om::ThreeAngles theAngles{};
+		bool theHasConvention{ false };
+		bool theHasDistances{ false };
+		bool theHasAngles{ false };
+
+	}; // KeyRecords
+
+	/*! \brief Convention, distance and angle records for each sensor key.
+	 *
+	 * Keys (in sorted order) are views into text. Records with keyword
+	 * distKeyword provide distances. Records with invalid values are
+	 * ignored and later valid records replace earlier ones.
+	 */
+	inline
+	std::map<std::string_view, KeyRecords>
+	keyRecordsFrom
+		( std::string_view const & text
+		, std::string_view const & distKeyword
+		)
+	{
+		std::map<std::string_view, KeyRecords> keyRecs;
+		std::string_view keyword;
+		std::string_view senKey;
+		std::size_t linePos{ 0u };
+		while (linePos < text.size())
+		{
+			std::string_view const record
+				{ recordFrom(nextLine(text, &linePos)) };
+			if (! record.empty())
+			{
+				std::size_t pos{ 0u };
+				( fieldFrom(record, &pos, &keyword)
+				&& fieldFrom(record, &pos, &senKey)
+				);
+				if ("Convention:" == keyword)
+				{
+					om::ConventionString const cs
+						{ om::ConventionString::from(record.substr(pos)) };
+					if (cs.isValid())
+					{
+						KeyRecords & recs = keyRecs[senKey];
+						recs.theConvention = cs.convention();
+						recs.theHasConvention = true;
+					}
+				}
+				else
+				if (distKeyword == keyword)
+				{
+					om::ThreeDistances const dists
+						{ threeValuesFrom(record, &pos) };
+					if (engabra::g3::isValid(dists))
+					{
+						KeyRecords & recs = keyRecs[senKey];
+						recs.theDistances = dists;
+						recs.theHasDistances = true;
+					}
+				}
+				else
+				if ("Angles:" == keyword)
+				{
+					om::ThreeAngles const angles
+						{ threeValuesFrom(record, &pos) };
+					if (engabra::g3::isValid(angles))
+					{
+						KeyRecords & recs = keyRecs[senKey];
+						recs.theAngles = angles;
+						recs.theHasAngles = true;
+					}
+				}
+			} // record parsing
+		} // text reading
+		return keyRecs;
+	}
+
+} // [anon]
+
 
 namespace om
 {
@@ -84,166 +369,77 @@ loadIndEOs
 	( std::istream & istrm
 	)
 {
-	std::map<SenKey, SenOri> indOris;
+	std::string const text
+		{ std::istreambuf_iterator<char>(istrm)
+		, std::istreambuf_iterator<char>()
+		};
+	return loadIndEOs(std::string_view(text));
+}
 
-	std::string line;
-	std::string keyword;
-	std::string senKey;
-	std::set<SenKey> senKeys;
-	std::map<SenKey, Convention> keyConventions;
-	std::map<SenKey, ThreeDistances> keyDistances;
-	std::map<SenKey, ThreeAngles> keyAngles;
-	while (istrm.good() && (! istrm.eof()))
-	{
-		line.clear();
-		std::getline(istrm, line);
-		std::string const record
-			{ trimmed(withoutComment(line)) };
-		if (! record.empty())
-		{
-			std::istringstream iss(record);
-			iss >> keyword >> senKey;
-			if ("Convention:" == keyword)
-			{
-				std::string encoding;
-				std::getline(iss, encoding);
-				ConventionString const cs
-					{ ConventionString::from(encoding) };
-				if (cs.isValid())
-				{
-					Convention const convention{ cs.convention() };
-					keyConventions[senKey] = convention;
-					senKeys.insert(senKey);
-				}
-			}
-			else
-			if ("Locations:" == keyword)
-			{
-				ThreeDistances dists
-					{ engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					};
-				iss >> dists[0] >> dists[1] >> dists[2];
-				using namespace engabra::g3;
-				if (isValid(dists))
-				{
-					keyDistances[senKey] = dists;
-					senKeys.insert(senKey);
-				}
-			}
-			else
-			if ("Angles:" == keyword)
-			{
-				ThreeAngles angles
-					{ engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					};
-				iss >> angles[0] >> angles[1] >> angles[2];
-				using namespace engabra::g3;
-				if (isValid(angles))
-				{
-					keyAngles[senKey] = angles;
-					senKeys.insert(senKey);
-				}
-			}
-		} // record parsing
-	} // stream reading
+std::map<SenKey, SenOri>
+loadIndEOs
+	( std::string_view const & text
+	)
+{
+	std::map<SenKey, SenOri> indOris;
 
-	for (SenKey const & senKey : senKeys)
+	std::map<std::string_view, KeyRecords> const keyRecs
+		{ keyRecordsFrom(text, "Locations:") };
+	for (std::map<std::string_view, KeyRecords>::value_type
+		const & keyRec : keyRecs)
 	{
-		std::map<SenKey, Convention>::const_iterator
-			const itConvention{ keyConventions.find(senKey) };
-		std::map<SenKey, ThreeDistances>::const_iterator
-			const itDistance{ keyDistances.find(senKey) };
-		std::map<SenKey, ThreeAngles>::const_iterator
-			const itAngle{ keyAngles.find(senKey) };
-		if ( (keyConventions.end() != itConvention)
-		  && (keyDistances.end() != itDistance)
-		  && (keyAngles.end() != itAngle)
-		   )
+		KeyRecords const & recs = keyRec.second;
+		if (recs.theHasConvention && recs.theHasDistances && recs.theHasAngles)
 		{
-			Convention const & convention = itConvention->second;
-			ParmGroup const pg{ itDistance->second, itAngle->second };
-			SenOri const indOri{ convention.transformFor(pg) };
-			indOris[senKey] = indOri;
+			ParmGroup const pg{ recs.theDistances, recs.theAngles };
+			SenOri const indOri{ recs.theConvention.transformFor(pg) };
+			indOris.emplace_hint(indOris.end(), keyRec.first, indOri);
 		}
 	}
 
 	return indOris;
 }
 
+std::map<SenKey, SenOri>
+loadIndEOsFile
+	( std::filesystem::path const & path
+	)
+{
+	FileBytes const bytes(path.string());
+	return loadIndEOs(bytes.view());
+}
+
 std::map<SenKey, ParmGroup>
 loadParmGroups
 	( std::istream & istrm
 	)
+{
+	std::string const text
+		{ std::istreambuf_iterator<char>(istrm)
+		, std::istreambuf_iterator<char>()
+		};
+	return loadParmGroups(std::string_view(text));
+}
+
+std::map<SenKey, ParmGroup>
+loadParmGroups
+	( std::string_view const & text
+	)
 {
 	std::map<SenKey, ParmGroup> pgs;
-	std::string line;
-	std::string keyword;
-	std::string senKey;
-	std::set<SenKey> senKeys;
-	std::map<SenKey, ThreeDistances> keyDistances;
-	std::map<SenKey, ThreeAngles> keyAngles;
-	while (istrm.good() && (! istrm.eof()))
-	{
-		line.clear();
-		std::getline(istrm, line);
-		std::string const record
-			{ trimmed(withoutComment(line)) };
-		if (! record.empty())
-		{
-			std::istringstream iss(record);
-			iss >> keyword >> senKey;
-			if ("Distances:" == keyword)
-			{
-				ThreeDistances dists
-					{ engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					};
-				iss >> dists[0] >> dists[1] >> dists[2];
-				using namespace engabra::g3;
-				if (isValid(dists))
-				{
-					keyDistances[senKey] = dists;
-					senKeys.insert(senKey);
-				}
-			}
-			else
-			if ("Angles:" == keyword)
-			{
-				ThreeAngles angles
-					{ engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					, engabra::g3::null<double>()
-					};
-				iss >> angles[0] >> angles[1] >> angles[2];
-				using namespace engabra::g3;
-				if (isValid(angles))
-				{
-					keyAngles[senKey] = angles;
-					senKeys.insert(senKey);
-				}
-			}
-		} // record parsing
-	} // stream reading
 
-	for (SenKey const & senKey : senKeys)
+	std::map<std::string_view, KeyRecords> const keyRecs
+		{ keyRecordsFrom(text, "Distances:") };
+	for (std::map<std::string_view, KeyRecords>::value_type
+		const & keyRec : keyRecs)
 	{
-		std::map<SenKey, ThreeDistances>::const_iterator
-			const itDistance{ keyDistances.find(senKey) };
-		std::map<SenKey, ThreeAngles>::const_iterator
-			const itAngle{ keyAngles.find(senKey) };
-		if ( (keyDistances.end() != itDistance)
-		  && (keyAngles.end() != itAngle)
-		   )
+		KeyRecords const & recs = keyRec.second;
+		if (recs.theHasDistances && recs.theHasAngles)
 		{
-			ParmGroup const pg{ itDistance->second, itAngle->second };
+			ParmGroup const pg{ recs.theDistances, recs.theAngles };
 			if (pg.isValid())
 			{
-				pgs[senKey] = pg;
+				pgs.emplace_hint(pgs.end(), keyRec.first, pg);
 			}
 		}
 	}
@@ -251,6 +447,15 @@ loadParmGroups
 	return pgs;
 }
 
+std::map<SenKey, ParmGroup>
+loadParmGroupsFile
+	( std::filesystem::path const & path
+	)
+{
+	FileBytes const bytes(path.string());
+	return loadParmGroups(bytes.view());
+}
+
 std::string
 infoString
 	( FitNdxPair const & fitConPair
@@ -260,12 +465,12 @@ infoString
 	std::ostringstream oss;
 	double const & fitError = fitConPair.first;
 	Convention const & convention = allConventions[fitConPair.second];
-	ConventionString const cs{ ConventionString::from(convention) };
+	ConventionText const text{ ConventionText::from(convention) };
 	using engabra::g3::io::fixed;
 	oss
 		<< " fitError: " << fixed(fitError)
 		<< "  convention: " << convention.numberEncoding()
-		<< " '" << cs.stringEncoding() << "'"
+		<< " '" << text.view() << "'"
 		;
 	return oss.str();
 }
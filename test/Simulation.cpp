@@ -29,6 +29,207 @@
 
 #include "Simulation.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+
+namespace
+{
+	//! Sum of squared differences between basis images of att and expAtt
+	inline
+	double
+	costFor
+		( rigibra::Attitude const & att
+		, rigibra::Attitude const & expAtt
+		)
+	{
+		using namespace engabra::g3;
+		return
+			( magSq(att(e1) - expAtt(e1))
+			+ magSq(att(e2) - expAtt(e2))
+			+ magSq(att(e3) - expAtt(e3))
+			);
+	}
+
+	//! Residuals - differences of basis images (as in costFor()).
+	inline
+	std::array<double, 9u>
+	residualsFor
+		( om::Convention const & convention
+		, om::ThreeAngles const & angles
+		, rigibra::Attitude const & expAtt
+		)
+	{
+		using namespace engabra::g3;
+		om::ParmGroup const pg{ { 0., 0., 0. }, angles };
+		rigibra::Attitude const att{ convention.attitudeFor(pg) };
+		std::array<Vector, 3u> const basis{ e1, e2, e3 };
+		std::array<double, 9u> resids{};
+		for (std::size_t nb{0u} ; nb < 3u ; ++nb)
+		{
+			Vector const diff{ att(basis[nb]) - expAtt(basis[nb]) };
+			resids[3u*nb + 0u] = diff[0];
+			resids[3u*nb + 1u] = diff[1];
+			resids[3u*nb + 2u] = diff[2];
+		}
+		return resids;
+	}
+
+	//! Sum of squared residuals
+	inline
+	double
+	sumSqOf
+		( std::array<double, 9u> const & resids
+		)
+	{
+		double sumSq{ 0. };
+		for (double const & resid : resids)
+		{
+			sumSq += resid * resid;
+		}
+		return sumSq;
+	}
+
+	/*! \brief Angles (for convention) adjusted from start to match expAtt.
+	 *
+	 * Levenberg-Marquardt iteration with numerical partial derivatives.
+	 */
+	inline
+	om::ThreeAngles
+	anglesAdjusted
+		( om::Convention const & convention
+		, om::ThreeAngles const & start
+		, rigibra::Attitude const & expAtt
+		)
+	{
+		constexpr double tolSumSq{ 1.e-28 };
+		constexpr double delta{ 1.e-7 };
+		constexpr std::size_t maxIter{ 100u };
+
+		om::ThreeAngles angles{ start };
+		std::array<double, 9u> resids
+			{ residualsFor(convention, angles, expAtt) };
+		double sumSq{ sumSqOf(resids) };
+		double lambda{ 1.e-3 };
+		for (std::size_t iter{0u}
+			; (iter < maxIter) && (tolSumSq < sumSq) ; ++iter)
+		{
+			// Jacobian (by central differences) in column order
+			std::array<std::array<double, 9u>, 3u> jacs{};
+			for (std::size_t na{0u} ; na < 3u ; ++na)
+			{
+				om::ThreeAngles anglesP{ angles };
+				om::ThreeAngles anglesM{ angles };
+				anglesP[na] += delta;
+				anglesM[na] -= delta;
+				std::array<double, 9u> const residsP
+					{ residualsFor(convention, anglesP, expAtt) };
+				std::array<double, 9u> const residsM
+					{ residualsFor(convention, anglesM, expAtt) };
+				for (std::size_t nr{0u} ; nr < 9u ; ++nr)
+				{
+					jacs[na][nr] = (residsP[nr] - residsM[nr]) / (2.*delta);
+				}
+			}
+
+			// normal equations: (JtJ + lambda*diag(JtJ)) * step = -Jt*r
+			std::array<std::array<double, 3u>, 3u> nMat{};
+			std::array<double, 3u> rhs{};
+			for (std::size_t n1{0u} ; n1 < 3u ; ++n1)
+			{
+				for (std::size_t n2{0u} ; n2 < 3u ; ++n2)
+				{
+					for (std::size_t nr{0u} ; nr < 9u ; ++nr)
+					{
+						nMat[n1][n2] += jacs[n1][nr] * jacs[n2][nr];
+					}
+				}
+				for (std::size_t nr{0u} ; nr < 9u ; ++nr)
+				{
+					rhs[n1] -= jacs[n1][nr] * resids[nr];
+				}
+				nMat[n1][n1] += lambda * nMat[n1][n1] + 1.e-15;
+			}
+
+			// solve by Cramer's rule
+			auto const det3
+				{ [] (std::array<std::array<double, 3u>, 3u> const & mat)
+					{
+						return
+							( mat[0][0] * (mat[1][1]*mat[2][2]
+								- mat[1][2]*mat[2][1])
+							- mat[0][1] * (mat[1][0]*mat[2][2]
+								- mat[1][2]*mat[2][0])
+							+ mat[0][2] * (mat[1][0]*mat[2][1]
+								- mat[1][1]*mat[2][0])
+							);
+					}
+				};
+			double const det{ det3(nMat) };
+			om::ThreeAngles trial{ angles };
+			for (std::size_t nc{0u} ; nc < 3u ; ++nc)
+			{
+				std::array<std::array<double, 3u>, 3u> colMat{ nMat };
+				for (std::size_t nr{0u} ; nr < 3u ; ++nr)
+				{
+					colMat[nr][nc] = rhs[nr];
+				}
+				trial[nc] += det3(colMat) / det;
+			}
+
+			// accept improvements (and reduce damping) or increase damping
+			std::array<double, 9u> const trialResids
+				{ residualsFor(convention, trial, expAtt) };
+			double const trialSumSq{ sumSqOf(trialResids) };
+			if (trialSumSq < sumSq)
+			{
+				angles = trial;
+				resids = trialResids;
+				sumSq = trialSumSq;
+				lambda = std::max(1.e-12, .1 * lambda);
+			}
+			else
+			{
+				lambda = 10. * lambda;
+			}
+		}
+		return angles;
+	}
+
+	//! Angle value equivalent to angle in the range [-pi,pi).
+	inline
+	double
+	principalAngle
+		( double const & angle
+		)
+	{
+		constexpr double pi{ 3.14159265358979323846 };
+		double const turns{ std::floor((angle + pi) / (2.*pi)) };
+		return (angle - turns * (2.*pi));
+	}
+
+	//! Sensor key for sensor number ndx (zero padded to sort in order).
+	inline
+	om::SenKey
+	senKeyFor
+		( std::size_t const & ndx
+		, std::size_t const & numSen
+		)
+	{
+		std::size_t const width{ std::to_string(numSen).size() };
+		std::ostringstream oss;
+		oss << "sen" << std::setw(width) << std::setfill('0') << ndx;
+		return oss.str();
+	}
+
+} // [anon]
+
 
 namespace om
 {
@@ -73,6 +274,242 @@ independentKeyOris
 	return indKeyOris;
 }
 
+om::ParmGroup
+parmGroupFor
+	( SenOri const & ori
+	, om::Convention const & convention
+	)
+{
+	using namespace engabra::g3;
+
+	// angles: best match from several starting values
+	constexpr std::array<double, 3u> starts{ -2., .5, 2. };
+	constexpr double tolCost{ 1.e-24 };
+	ThreeAngles angles{ 0., 0., 0. };
+	double cost{ std::numeric_limits<double>::max() };
+	for (std::size_t nn{0u} ; (nn < 27u) && (tolCost < cost) ; ++nn)
+	{
+		ThreeAngles const start
+			{ starts[nn % 3u], starts[(nn / 3u) % 3u], starts[nn / 9u] };
+		ThreeAngles const trial
+			{ anglesAdjusted(convention, start, ori.theAtt) };
+		double const trialCost
+			{ costFor
+				(convention.attitudeFor(ParmGroup{ { 0., 0., 0. }, trial })
+				, ori.theAtt
+				)
+			};
+		if (trialCost < cost)
+		{
+			angles = trial;
+			cost = trialCost;
+		}
+	}
+	for (double & angle : angles)
+	{
+		angle = principalAngle(angle);
+	}
+
+	// distances: location is an orthogonal function of distance values
+	ThreeDistances dists{ 0., 0., 0. };
+	for (std::size_t nd{0u} ; nd < 3u ; ++nd)
+	{
+		ThreeDistances unitDists{ 0., 0., 0. };
+		unitDists[nd] = 1.;
+		Vector const unitLoc
+			{ convention.transformFor(ParmGroup{ unitDists, angles }).theLoc };
+		dists[nd] = unitLoc[0] * ori.theLoc[0]
+			+ unitLoc[1] * ori.theLoc[1]
+			+ unitLoc[2] * ori.theLoc[2];
+	}
+
+	return ParmGroup{ dists, angles };
+}
+
+std::string
+parmGroupText
+	( std::map<om::SenKey, om::ParmGroup> const & keyGroups
+	)
+{
+	std::ostringstream oss;
+	oss.precision(17);
+	for (std::map<SenKey, ParmGroup>::value_type
+		const & keyGroup : keyGroups)
+	{
+		ThreeDistances const & dists = keyGroup.second.theDistances;
+		ThreeAngles const & angles = keyGroup.second.theAngles;
+		oss << "Distances: " << keyGroup.first
+			<< ' ' << dists[0] << ' ' << dists[1] << ' ' << dists[2]
+			<< '\n';
+		oss << "Angles: " << keyGroup.first
+			<< ' ' << angles[0] << ' ' << angles[1] << ' ' << angles[2]
+			<< '\n';
+	}
+	return oss.str();
+}
+
+std::string
+indEOText
+	( std::map<om::SenKey, om::ParmGroup> const & keyGroups
+	, om::Convention const & convention
+	)
+{
+	// field order as decoded by loadIndEOs() via ConventionString
+	// (offset fields first, unlike ConventionString::from(convention))
+	std::string const conText
+		{ ConventionString
+			{ stringFrom(convention.theConvOff.theOffSigns)
+			, stringFrom(convention.theConvOff.theOffIndices)
+			, stringFrom(convention.theConvAng.theAngSigns)
+			, stringFrom(convention.theConvAng.theAngIndices)
+			, stringFrom(convention.theConvAng.theBivIndices)
+			, stringFrom(convention.theOrder)
+			}.stringEncoding()
+		};
+	std::ostringstream oss;
+	oss.precision(17);
+	for (std::map<SenKey, ParmGroup>::value_type
+		const & keyGroup : keyGroups)
+	{
+		ThreeDistances const & dists = keyGroup.second.theDistances;
+		ThreeAngles const & angles = keyGroup.second.theAngles;
+		oss << "Convention: " << keyGroup.first << ' ' << conText << '\n';
+		oss << "Locations: " << keyGroup.first
+			<< ' ' << dists[0] << ' ' << dists[1] << ' ' << dists[2]
+			<< '\n';
+		oss << "Angles: " << keyGroup.first
+			<< ' ' << angles[0] << ' ' << angles[1] << ' ' << angles[2]
+			<< '\n';
+	}
+	return oss.str();
+}
+
+Payload
+Payload :: from
+	( PayloadSpec const & spec
+	)
+{
+	Payload payload;
+
+	constexpr double pi{ 3.14159265358979323846 };
+	std::mt19937_64 gen(spec.theSeed);
+	std::uniform_real_distribution<double> unitDist(-1., 1.);
+
+	// ground truth conventions (random values are always generated
+	// such that other values depend only on the seed - e.g. the Box
+	// ParmGroups are the same for all specified conventions)
+	std::uniform_int_distribution<std::size_t>
+		boxConDist(0u, Convention::theNumConventions - 1u);
+	ConventionId const randBoxConvId
+		{ static_cast<ConventionId>(boxConDist(gen)) };
+	ConventionOffset const indConvOffset{ { 1, 1, 1 }, { 0u, 1u, 2u } };
+	std::vector<Convention> const indCons // as for OriAnalysis allIndCons
+		{ Convention::allConventionsFor(indConvOffset) };
+	std::uniform_int_distribution<std::size_t>
+		indConDist(0u, indCons.size() - 1u);
+	Convention const randIndCon{ indCons[indConDist(gen)] };
+
+	payload.theBoxConvention = conventionFor(randBoxConvId);
+	if (spec.theBoxConvId < Convention::theNumConventions)
+	{
+		payload.theBoxConvention = conventionFor(spec.theBoxConvId);
+	}
+	payload.theIndConvention = randIndCon;
+	if (spec.theIndConvId < Convention::theNumConventions)
+	{
+		payload.theIndConvention = conventionFor(spec.theIndConvId);
+	}
+
+	// ground truth Box frame placement
+	double const locScale{ 10. * spec.theMaxDistance };
+	double const ang0{ unitDist(gen) };
+	double const ang1{ unitDist(gen) };
+	double const ang2{ unitDist(gen) };
+	double const loc0{ unitDist(gen) };
+	double const loc1{ unitDist(gen) };
+	double const loc2{ unitDist(gen) };
+	payload.theXfmBoxWrtRef = rigibra::Transform
+		{ rigibra::Location{ locScale*loc0, locScale*loc1, locScale*loc2 }
+		, rigibra::Attitude
+			(rigibra::PhysAngle{ 1.5*ang0, 1.5*ang1, 1.5*ang2 })
+		};
+
+	// Box parameter groups
+	std::size_t const & numSen = spec.theNumSensors;
+	for (std::size_t nSen{0u} ; nSen < numSen ; ++nSen)
+	{
+		ParmGroup pg;
+		for (double & dist : pg.theDistances)
+		{
+			dist = spec.theMaxDistance * unitDist(gen);
+		}
+		for (double & angle : pg.theAngles)
+		{
+			angle = pi * unitDist(gen);
+		}
+		payload.theBoxKeyPGs.emplace_hint
+			(payload.theBoxKeyPGs.end(), senKeyFor(nSen, numSen), pg);
+	}
+
+	// Ind parameter groups (with noise) and corresponding orientations
+	std::normal_distribution<double> noiseDist(0., 1.);
+	std::map<SenKey, SenOri> const indKeyOris
+		{ independentKeyOris
+			( boxKeyOris(payload.theBoxKeyPGs, payload.theBoxConvention)
+			, payload.theXfmBoxWrtRef
+			)
+		};
+	for (std::map<SenKey, SenOri>::value_type const & indKeyOri : indKeyOris)
+	{
+		ParmGroup pg
+			{ parmGroupFor(indKeyOri.second, payload.theIndConvention) };
+		if (0. < spec.theDistanceSigma)
+		{
+			for (double & dist : pg.theDistances)
+			{
+				dist += spec.theDistanceSigma * noiseDist(gen);
+			}
+		}
+		if (0. < spec.theAngleSigma)
+		{
+			for (double & angle : pg.theAngles)
+			{
+				angle += spec.theAngleSigma * noiseDist(gen);
+			}
+		}
+		payload.theIndKeyPGs.emplace_hint
+			(payload.theIndKeyPGs.end(), indKeyOri.first, pg);
+		payload.theIndKeyOris.emplace_hint
+			( payload.theIndKeyOris.end(), indKeyOri.first
+			, payload.theIndConvention.transformFor(pg)
+			);
+	}
+
+	return payload;
+}
+
+bool
+Payload :: saveParmGroups
+	( std::filesystem::path const & boxPGPath
+	, std::filesystem::path const & indPGPath
+	) const
+{
+	bool okay{ true };
+	if (! boxPGPath.empty())
+	{
+		std::ofstream ofs(boxPGPath);
+		ofs << parmGroupText(theBoxKeyPGs);
+		okay = okay && (! ofs.fail());
+	}
+	if (! indPGPath.empty())
+	{
+		std::ofstream ofs(indPGPath);
+		ofs << parmGroupText(theIndKeyPGs);
+		okay = okay && (! ofs.fail());
+	}
+	return okay;
+}
+
 } // [sim]
 } // [om]
 
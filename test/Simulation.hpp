@@ -27,10 +27,10 @@
 #define OriMania_sim_INCL_
 
 /*! \file
-\brief Contains ######
+\brief Simulation of payload data (fixed fixtures and seeded generator).
 
 Example:
-\snippet test_sim.cpp DoxyExample01
+\snippet test_Simulation.cpp DoxyExample01
 
 */
 
@@ -40,7 +40,10 @@ Example:
 
 #include <Rigibra>
 
+#include <cstdint>
+#include <filesystem>
 #include <map>
+#include <string>
 
 
 
@@ -104,6 +107,114 @@ namespace sim
 		, SenOri const & oriBoxWrtRef = om::sim::sXfmBoxWrtRef
 		);
 
+	/*! \brief Parameters (e.g. angles) for ori expressed in convention.
+	 *
+	 * This is the inverse of convention.transformFor(): the result
+	 * is such that convention.transformFor(result) reproduces ori (to
+	 * within numerical precision). Angles are in the range [-pi,pi).
+	 *
+	 * Angles are found by iterative (Levenberg-Marquardt) adjustment
+	 * from several starting values, and distances from the (orthogonal)
+	 * relationship between distance values and the location of ori.
+	 */
+	om::ParmGroup
+	parmGroupFor
+		( SenOri const & ori
+		, om::Convention const & convention
+		);
+
+	//! Text for keyGroups that can be read by om::loadParmGroups().
+	std::string
+	parmGroupText
+		( std::map<om::SenKey, om::ParmGroup> const & keyGroups
+		);
+
+	//! Text for keyGroups (in convention) readable by om::loadIndEOs().
+	std::string
+	indEOText
+		( std::map<om::SenKey, om::ParmGroup> const & keyGroups
+		, om::Convention const & convention
+		);
+
+	//! Specification for synthetic payload data (ref Payload::from()).
+	struct PayloadSpec
+	{
+		//! Number of sensors to simulate (e.g. 10 to 10,000).
+		std::size_t theNumSensors{ 10u };
+
+		//! Seed for pseudo-random generation (same seed, same payload).
+		std::uint64_t theSeed{ 1u };
+
+		//! Box convention (random if sNullConventionId).
+		om::ConventionId theBoxConvId{ om::sNullConventionId };
+
+		//! Ind convention (random, with offset +++ 012, if null).
+		om::ConventionId theIndConvId{ om::sNullConventionId };
+
+		//! Box distance values are uniformly distributed in [-max,max).
+		double theMaxDistance{ 100. };
+
+		//! Standard deviation of noise added to Ind distance values.
+		double theDistanceSigma{ 0. };
+
+		//! Standard deviation of noise added to Ind angle values.
+		double theAngleSigma{ 0. };
+
+	}; // PayloadSpec
+
+	/*! \brief Synthetic payload with known (ground truth) conventions.
+	 *
+	 * The Box ParmGroups have random distances and angles. These are
+	 * interpreted with theBoxConvention to obtain sensor orientations
+	 * in the Box frame. The Box frame is placed in the Ind (Ref) frame
+	 * by theXfmBoxWrtRef and the resulting sensor orientations are
+	 * expressed in theIndConvention as Ind ParmGroups to which the
+	 * (optional) Gaussian noise is added.
+	 *
+	 * Random values other than the conventions depend only on the seed
+	 * (and counts) in the spec. E.g. payloads for which only the Box
+	 * convention is different have identical Box ParmGroups.
+	 */
+	struct Payload
+	{
+		//! Ground truth: convention for interpreting theBoxKeyPGs.
+		om::Convention theBoxConvention{};
+
+		//! Ground truth: convention for interpreting theIndKeyPGs.
+		om::Convention theIndConvention{};
+
+		//! Ground truth: Box frame with respect to Ind reference frame.
+		SenOri theXfmBoxWrtRef{};
+
+		//! Box (interior) parameter groups.
+		std::map<om::SenKey, om::ParmGroup> theBoxKeyPGs{};
+
+		//! Ind (exterior) parameter groups (including noise).
+		std::map<om::SenKey, om::ParmGroup> theIndKeyPGs{};
+
+		//! Ind orientations - theIndConvention.transformFor(theIndKeyPGs).
+		std::map<om::SenKey, om::SenOri> theIndKeyOris{};
+
+		//! Payload generated according to spec.
+		static
+		Payload
+		from
+			( PayloadSpec const & spec
+			);
+
+		/*! \brief Write Box and Ind ParmGroup files (as for OriAnalysis).
+		 *
+		 * Each file is readable with om::loadParmGroupsFile(). Empty
+		 * paths are skipped. Return is true if all writes succeed.
+		 */
+		bool
+		saveParmGroups
+			( std::filesystem::path const & boxPGPath
+			, std::filesystem::path const & indPGPath
+			) const;
+
+	}; // Payload
+
 } // [sim]
 } // [om]
 
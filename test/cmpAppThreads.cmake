@@ -0,0 +1,70 @@
+#
+# MIT License
+#
+# Copyright (c) 2024 Stellacore Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+##
+## -- End-to-end check: OriAnalysis output independent of thread counts
+##
+## Usage (ref test/CMakeLists.txt):
+##   cmake -DProg=<OriAnalysis> -DBoxPath=<file> -DIndPath=<file>
+##     -DWorkDir=<dir> -P cmpAppThreads.cmake
+##
+
+# thread options (':' separated) for each run - first one is reference
+set(threadCases
+	"--threads:1"
+	"--threads:4"
+	"--threads:4:--fit-threads:2"
+	"--threads:3:--fit-threads:3"
+	)
+
+set(refPath "")
+foreach(threadCase ${threadCases})
+
+	string(REPLACE ":" ";" threadArgs "${threadCase}")
+	string(REPLACE ":" "_" caseName "${threadCase}")
+	set(outPath "${WorkDir}/cmpAppThreads${caseName}.txt")
+
+	execute_process(
+		COMMAND ${Prog} ${BoxPath} ${IndPath} ${outPath} ${threadArgs}
+		RESULT_VARIABLE runStatus
+		OUTPUT_QUIET
+		)
+	if (NOT runStatus EQUAL 0)
+		message(FATAL_ERROR "Failure of run with: ${threadArgs}")
+	endif()
+
+	if (refPath STREQUAL "")
+		set(refPath "${outPath}")
+	else()
+		execute_process(
+			COMMAND ${CMAKE_COMMAND} -E compare_files ${refPath} ${outPath}
+			RESULT_VARIABLE cmpStatus
+			)
+		if (NOT cmpStatus EQUAL 0)
+			message(FATAL_ERROR
+				"Failure of thread test: ${outPath} differs from ${refPath}")
+		endif()
+	endif()
+
+endforeach(threadCase)
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
@@ -54,6 +55,59 @@ namespace om
 
 namespace
 {
+	/*! \brief Tolerance for fit errors computed via different paths.
+	 *
+	 * E.g. Box ROs from the OriBatch kernels (BoxRelOriTable) and from
+	 * rigibra operations (keyed evaluation) agree only to within a few
+	 * ulps depending on the math library and compiler code generation.
+	 */
+	constexpr double sFitTol{ 1.e-9 };
+
+	//! True if values are the same (to within sFitTol relative to size).
+	inline
+	bool
+	nearlyEqualFits
+		( double const & fitA
+		, double const & fitB
+		)
+	{
+		double const mag{ 1. + std::max(std::abs(fitA), std::abs(fitB)) };
+		return (! (sFitTol*mag < std::abs(fitA - fitB)));
+	}
+
+	//! True if sizes are the same and each element is nearlyEqualFits().
+	inline
+	bool
+	nearlyEqualFits
+		( std::vector<double> const & fitsA
+		, std::vector<double> const & fitsB
+		)
+	{
+		bool same{ fitsA.size() == fitsB.size() };
+		for (std::size_t nn{0u} ; same && (nn < fitsA.size()) ; ++nn)
+		{
+			same = nearlyEqualFits(fitsA[nn], fitsB[nn]);
+		}
+		return same;
+	}
+
+	//! True if indices are the same and fit values are nearlyEqualFits().
+	inline
+	bool
+	nearlyEqualFits
+		( std::vector<om::FitNdxPair> const & pairsA
+		, std::vector<om::FitNdxPair> const & pairsB
+		)
+	{
+		bool same{ pairsA.size() == pairsB.size() };
+		for (std::size_t nn{0u} ; same && (nn < pairsA.size()) ; ++nn)
+		{
+			same = (pairsA[nn].second == pairsB[nn].second)
+				&& nearlyEqualFits(pairsA[nn].first, pairsB[nn].first);
+		}
+		return same;
+	}
+
 	//! Check convention extraction from simulated data
 	void
 	testSim
@@ -198,6 +252,747 @@ namespace
 
 	} // testSim
 
+	//! Check fit errors from precomputed Box RO table
+	void
+	testBoxTable
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		std::map<SenKey, SenOri> const indKeyOris
+			{ om::sim::independentKeyOris
+				(om::sim::boxKeyOris(keyGroups, om::sim::sConventionA))
+			};
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+
+		std::vector<FitNdxPair> const expFitNdxPairs
+			{ fitIndexPairsFor(keyGroups, indKeyOris, allCons) };
+
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from(keyGroups, allCons) };
+		std::vector<FitNdxPair> const gotFitNdxPairs
+			{ fitIndexPairsFor(boxTable, indKeyOris) };
+
+		if (! nearlyEqualFits(gotFitNdxPairs, expFitNdxPairs))
+		{
+			oss << "Failure of BoxRelOriTable fit error test\n";
+			oss << "exp size: " << expFitNdxPairs.size() << '\n';
+			oss << "got size: " << gotFitNdxPairs.size() << '\n';
+		}
+
+		// same evaluation using SenNdx ordered (dense) data
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+		BoxRelOriTable const denseTable
+			{ BoxRelOriTable::from
+				(registry, attitudeTablesFor(registry, keyGroups), allCons)
+			};
+		std::vector<AttitudeTable> const indTables
+			{ attitudeTablesFor(registry, keyGroups) };
+		std::map<SenKey, SenOri> const simKeyOris
+			{ keyOrisFor(keyGroups, om::sim::sConventionA) };
+		std::vector<FitNdxPair> const expDenseFitNdxPairs
+			{ fitIndexPairsFor(boxTable, simKeyOris) };
+		std::vector<FitNdxPair> const gotDenseFitNdxPairs
+			{ fitIndexPairsFor(denseTable, indTables, om::sim::sConventionA) };
+		if (! nearlyEqualFits(gotDenseFitNdxPairs, expDenseFitNdxPairs))
+		{
+			oss << "Failure of dense BoxRelOriTable fit error test\n";
+			oss << "exp size: " << expDenseFitNdxPairs.size() << '\n';
+			oss << "got size: " << gotDenseFitNdxPairs.size() << '\n';
+		}
+	}
+
+	//! Check basis vector fit metric against closed form values
+	void
+	testBasisMetric
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+		using namespace rigibra;
+		using engabra::g3::nearlyEquals;
+
+		// zero error for identity
+		SenOri const oriIdent{ SenOri::identity() };
+		double const gotIdent{ basisTransformRMSE(oriIdent) };
+		if (! nearlyEquals(gotIdent, 0.))
+		{
+			oss << "Failure of basisTransformRMSE identity test\n";
+			oss << "got: " << gotIdent << '\n';
+		}
+
+		// rotation by angle about any one axis moves the other two basis
+		// vectors each by chord length 2*sin(angle/2) (on 3 stat dof)
+		constexpr double angle{ .75 };
+		double const chordSq{ 4. * std::pow(std::sin(.5 * angle), 2.) };
+		double const expRMSE{ std::sqrt((2. * chordSq) / 3.) };
+		using engabra::g3::BiVector;
+		std::array<BiVector, 3u> const physAngles
+			{ BiVector{ angle, 0., 0. }
+			, BiVector{ 0., angle, 0. }
+			, BiVector{ 0., 0., angle }
+			};
+		for (BiVector const & physAngle : physAngles)
+		{
+			SenOri const ori
+				{ Location{ 0., 0., 0. }, Attitude{ PhysAngle{ physAngle } } };
+			double const gotRMSE{ basisTransformRMSE(ori) };
+			if (! nearlyEquals(gotRMSE, expRMSE))
+			{
+				oss << "Failure of basisTransformRMSE single axis test\n";
+				oss << "ori: " << ori << '\n';
+				oss << "exp: " << expRMSE << '\n';
+				oss << "got: " << gotRMSE << '\n';
+			}
+		}
+	}
+
+	//! Check closed form fit metric against basis vector transformation
+	void
+	testMetric
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+		using namespace rigibra;
+		using engabra::g3::nearlyEquals;
+
+		// zero error for identity
+		SenOri const oriIdent{ SenOri::identity() };
+		double const gotIdent{ rotorTransformRMSE(oriIdent) };
+		if (! nearlyEquals(gotIdent, 0.))
+		{
+			oss << "Failure of rotorTransformRMSE identity test\n";
+			oss << "got: " << gotIdent << '\n';
+		}
+
+		// same values as basis vector computation for various transforms
+		using engabra::g3::BiVector;
+		std::vector<SenOri> const someOris
+			{ SenOri{ Location{ 0., 0., 0. }
+				, Attitude{ PhysAngle{ BiVector{ .3, 0., 0. } } } }
+			, SenOri{ Location{ 1., -2., 3. }
+				, Attitude{ PhysAngle{ BiVector{ 0., 0., 0. } } } }
+			, SenOri{ Location{ 1., 2., 3. }
+				, Attitude{ PhysAngle{ BiVector{ .5, -.7, .2 } } } }
+			, SenOri{ Location{ -.5, 9., .1 }
+				, Attitude{ PhysAngle{ BiVector{ -2., 1., 3. } } } }
+			};
+		for (SenOri const & ori : someOris)
+		{
+			double const expRMSE{ basisTransformRMSE(ori) };
+			double const gotRMSE{ rotorTransformRMSE(ori) };
+			if (! nearlyEquals(gotRMSE, expRMSE))
+			{
+				oss << "Failure of rotorTransformRMSE test\n";
+				oss << "ori: " << ori << '\n';
+				oss << "exp: " << expRMSE << '\n';
+				oss << "got: " << gotRMSE << '\n';
+			}
+
+			// and policies agree for relative orientation comparisons
+			SenOri const & ori1 = someOris.back();
+			double const expBetween{ BasisMetric::rmseBetween(ori1, ori) };
+			double const gotBetween{ RotorMetric::rmseBetween(ori1, ori) };
+			if (! nearlyEquals(gotBetween, expBetween))
+			{
+				oss << "Failure of RotorMetric test\n";
+				oss << "exp: " << expBetween << '\n';
+				oss << "got: " << gotBetween << '\n';
+			}
+		}
+	}
+
+	//! Check streaming selection against full sort of fit errors
+	void
+	testSelector
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// selection from small collection (with tied error values)
+		std::vector<FitNdxPair> const somePairs
+			{ { 3., 0u }, { 1., 1u }, { 4., 2u }, { 1., 3u }
+			, { 5., 4u }, { 9., 5u }, { 2., 6u }, { 9., 7u }
+			};
+		std::vector<FitNdxPair> sortPairs{ somePairs };
+		std::sort(sortPairs.begin(), sortPairs.end());
+		for (std::size_t numBest{1u} ; numBest < 5u ; ++numBest)
+		{
+			std::vector<FitNdxPair> const expBests
+				(sortPairs.cbegin(), sortPairs.cbegin() + numBest);
+			FitNdxPair const & expWorst = sortPairs.back();
+
+			// all at once
+			FitNdxSelector const gotAll
+				{ fitSelectionFrom(somePairs, numBest) };
+
+			// in separate pieces, then merged
+			FitNdxSelector gotMerge{ FitNdxSelector::withNumBest(numBest) };
+			std::size_t const numHalf{ somePairs.size() / 2u };
+			gotMerge.merge
+				(fitSelectionFrom
+					( std::vector<FitNdxPair>
+						(somePairs.cbegin() + numHalf, somePairs.cend())
+					, numBest
+					)
+				);
+			gotMerge.merge
+				(fitSelectionFrom
+					( std::vector<FitNdxPair>
+						(somePairs.cbegin() + 1u, somePairs.cbegin() + numHalf)
+					, numBest
+					)
+				);
+			gotMerge.merge // single value (is both best and worst)
+				(fitSelectionFrom
+					( std::vector<FitNdxPair>
+						(somePairs.cbegin(), somePairs.cbegin() + 1u)
+					, numBest
+					)
+				);
+
+			for (FitNdxSelector const & got : { gotAll, gotMerge })
+			{
+				if (! ( (expBests == got.bests())
+					 && (expWorst == got.worst())
+					 && (somePairs.size() == got.theNumSeen)
+					  ) )
+				{
+					oss << "Failure of FitNdxSelector small test\n";
+					oss << "numBest: " << numBest << '\n';
+					oss << "exp size: " << expBests.size() << '\n';
+					oss << "got size: " << got.bests().size() << '\n';
+				}
+			}
+		}
+
+		// streaming selection of fits (all threads) vs collect and sort
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+		std::vector<AttitudeTable> const tables
+			{ attitudeTablesFor(registry, keyGroups) };
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from
+				(registry, tables, Convention::allConventions())
+			};
+		Convention const & indCon = om::sim::sConventionA;
+		std::vector<FitNdxPair> fitNdxPairs
+			{ fitIndexPairsFor(boxTable, tables, indCon) };
+		std::sort(fitNdxPairs.begin(), fitNdxPairs.end());
+		constexpr std::size_t numBest{ 5u };
+		std::vector<FitNdxPair> const expBests
+			(fitNdxPairs.cbegin(), fitNdxPairs.cbegin() + numBest);
+		for (std::size_t const numThreads : { 1u, 3u })
+		{
+			FitNdxSelector const got
+				{ fitSelectionFor
+					(boxTable, tables, indCon, numBest, numThreads)
+				};
+			if (! ( (expBests == got.bests())
+				 && (fitNdxPairs.back() == got.worst())
+				 && (fitNdxPairs.size() == got.theNumSeen)
+				 && (! got.theIsWorstBound)
+				  ) )
+			{
+				oss << "Failure of fitSelectionFor test\n";
+				oss << "numThreads: " << numThreads << '\n';
+				oss << "exp 1st: " << expBests.front().first << '\n';
+				oss << "got 1st: " << got.bests().front().first << '\n';
+			}
+
+			// branch-and-bound: same bests, worst is only a lower bound
+			FitNdxSelector const gotBB
+				{ fitSelectionPrunedFor
+					(boxTable, tables, indCon, numBest, numThreads)
+				};
+			if (! ( (expBests == gotBB.bests())
+				 && (! (fitNdxPairs.back().first < gotBB.worst().first))
+				 && (fitNdxPairs.size() == gotBB.theNumSeen)
+				 && gotBB.theIsWorstBound
+				  ) )
+			{
+				oss << "Failure of fitSelectionPrunedFor test\n";
+				oss << "numThreads: " << numThreads << '\n';
+				oss << "exp 1st: " << expBests.front().first << '\n';
+				oss << "got 1st: " << gotBB.bests().front().first << '\n';
+			}
+		}
+	}
+
+	//! Check report order of trials with (and without) bounded EndFit
+	void
+	testTrialOrder
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		auto const trialFor
+			{ []
+				( double const & fit2nd
+				, double const & fitEnd
+				, bool const & isBound
+				)
+				{
+					OneTrialResult trial;
+					trial.the1st.theFitError = 0.;
+					trial.the2nd.theFitError = fit2nd;
+					trial.theEnd.theFitError = fitEnd;
+					trial.theIsEndBound = isBound;
+					return trial;
+				}
+			};
+
+		// exact: large gap, small prominence (.1)
+		OneTrialResult const exactA{ trialFor(30., 300., false) };
+		// exact: small gap, large prominence (.5)
+		OneTrialResult const exactB{ trialFor(5., 10., false) };
+		// bound: as exactB, but with EndFit only a lower bound
+		OneTrialResult const boundB{ trialFor(5., 10., true) };
+
+		// all exact: by prominence
+		std::vector<OneTrialResult> gotExacts{ exactA, exactB };
+		sortForReport(&gotExacts);
+		// mixed: all by (exact) gap
+		std::vector<OneTrialResult> gotMixeds{ boundB, exactA };
+		sortForReport(&gotMixeds);
+
+		if (! ( (5. == gotExacts.front().the2nd.theFitError)
+			 && (30. == gotMixeds.front().the2nd.theFitError)
+			 && (5. == gotMixeds.back().the2nd.theFitError)
+			  ) )
+		{
+			oss << "Failure of sortForReport trial order test\n";
+			oss << "exact 1st gap: " << gotExacts.front().fitGap() << '\n';
+			oss << "mixed 1st gap: " << gotMixeds.front().fitGap() << '\n';
+		}
+	}
+
+	//! Check spatial index search for near fits against exhaustive search
+	void
+	testNear
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+		std::vector<AttitudeTable> const tables
+			{ attitudeTablesFor(registry, keyGroups) };
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from
+				(registry, tables, Convention::allConventions())
+			};
+		BoxRelOriIndex const boxIndex{ BoxRelOriIndex::from(boxTable) };
+
+		// every class within maxPairError (of each RO) is a candidate
+		constexpr double maxPairError{ 2. };
+		std::vector<Convention> const indCons
+			{ om::sim::sConventionA, conventionFor(ConventionId{ 777u }) };
+		for (Convention const & indCon : indCons)
+		{
+			std::vector<NdxRelOri> const indROs
+				{ indRelOrisFor(tables, indCon) };
+			std::size_t const numSen{ registry.size() };
+			for (NdxRelOri const & indRO : indROs)
+			{
+				OriBatch const & roBoxes
+					= *(boxTable.boxROsFor(indRO.theNdx1, indRO.theNdx2));
+				std::vector<std::size_t> const gotNdxs
+					{ boxIndex.classesNear
+						( indRO.theNdx1*numSen + indRO.theNdx2
+						, OriParts::from(indRO.theRelOri)
+						, maxPairError
+						)
+					};
+				std::size_t numMissing{ 0u };
+				for (std::size_t kNdx{0u} ; kNdx < roBoxes.size() ; ++kNdx)
+				{
+					double const fitError
+						{ RotorMetric::rmseBetween
+							(roBoxes, kNdx, indRO.theRelOri)
+						};
+					if ( (! (maxPairError < fitError))
+					  && (! std::binary_search
+							(gotNdxs.cbegin(), gotNdxs.cend(), kNdx))
+					   )
+					{
+						++numMissing;
+					}
+				}
+				if (! (0u == numMissing))
+				{
+					oss << "Failure of BoxRelOriIndex candidate test\n";
+					oss << "numMissing: " << numMissing << '\n';
+				}
+			}
+		}
+
+		// near selection (when exact) same as exhaustive search
+		Convention const & indCon = om::sim::sConventionA;
+		constexpr std::size_t numBest{ 1u };
+		NearSelection const gotNear
+			{ fitSelectionNearFor
+				(boxTable, boxIndex, tables, indCon, maxPairError, numBest)
+			};
+		FitNdxSelector const expSel
+			{ fitSelectionFor(boxTable, tables, indCon, numBest) };
+		if (! gotNear.isExact())
+		{
+			oss << "Failure of NearSelection isExact test\n";
+		}
+		else
+		if (! (gotNear.theSelector.bests() == expSel.bests()))
+		{
+			oss << "Failure of fitSelectionNearFor test\n";
+			oss << "exp 1st: " << expSel.bests().front().first << '\n';
+			oss << "got 1st: " << gotNear.theSelector.bests().front().first
+				<< '\n';
+		}
+
+		// near trial result (with exact best) has only a bound on worst
+		// (small first angle: its sign convention gives a close 2nd best)
+		using PG = ParmGroup;
+		std::map<SenKey, ParmGroup> const nearGroups
+			{ { "pgA", PG{ { -60.1,  10.3,  21.1 }, { .001, .2, .3 } } }
+			, { "pgB", PG{ {  10.7, -60.7,  31.1 }, { .001, .4, .5 } } }
+			, { "pgC", PG{ {  30.7,  22.7, -61.3 }, { .001, .6, .7 } } }
+			};
+		SenRegistry const nearRegistry{ SenRegistry::fromKeysOf(nearGroups) };
+		std::vector<AttitudeTable> const nearTables
+			{ attitudeTablesFor(nearRegistry, nearGroups) };
+		BoxRelOriTable const nearBoxTable
+			{ BoxRelOriTable::from
+				(nearRegistry, nearTables, Convention::allConventions())
+			};
+		NearSelection const nearSel
+			{ fitSelectionNearFor
+				( nearBoxTable, BoxRelOriIndex::from(nearBoxTable)
+				, nearTables, indCon, 1., 2u
+				)
+			};
+		OneTrialResult const nearResult
+			{ trialResultFrom
+				(nearSel.theSelector, Convention::allConventions(), indCon)
+			};
+		if (! (nearSel.isExact() && nearResult.theIsEndBound))
+		{
+			oss << "Failure of near trial result EndFit bound test\n";
+			oss << "isExact: " << nearSel.isExact() << '\n';
+			oss << "numSeen: " << nearSel.theSelector.theNumSeen << '\n';
+			oss << "theIsEndBound: " << nearResult.theIsEndBound << '\n';
+		}
+	}
+
+	//! Check per-sensor transforms against pairwise RO computation
+	void
+	testSensorTransforms
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		std::map<SenKey, AttitudeTable> const keyTables
+			{ attitudeTablesFor(keyGroups) };
+		SensorTransforms xfms{ SensorTransforms::from(keyTables) };
+
+		std::vector<Convention> const someCons
+			{ conventionFor(ConventionId{ 0u })
+			, conventionFor(ConventionId{ 12345u })
+			, om::sim::sConventionA
+			};
+		for (Convention const & convention : someCons)
+		{
+			xfms.setConvention(convention);
+			std::size_t ndx1{ 0u };
+			for (std::map<SenKey, ParmGroup>::value_type
+				const & keyGroup1 : keyGroups)
+			{
+				std::size_t ndx2{ 0u };
+				for (std::map<SenKey, ParmGroup>::value_type
+					const & keyGroup2 : keyGroups)
+				{
+					SenOri const expRO
+						{ relativeOrientationFor
+							(keyGroup1.second, keyGroup2.second, convention)
+						};
+					SenOri const gotRO{ xfms.relativeOrientation(ndx1, ndx2) };
+					if (! nearlyEquals(gotRO, expRO))
+					{
+						oss << "Failure of SensorTransforms RO test\n";
+						oss << "exp: " << expRO << '\n';
+						oss << "got: " << gotRO << '\n';
+						return;
+					}
+					++ndx2;
+				}
+				++ndx1;
+			}
+		}
+	}
+
+	//! Check evaluation by classes of equivalent conventions
+	void
+	testClasses
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+		using PG = ParmGroup;
+
+		// with zero angles, only the offset conventions are distinct
+		std::map<SenKey, ParmGroup> const keyGroups
+			{ { "pgA", PG{ { -60.1,  10.3,  21.1 }, { .0, .0, .0 } } }
+			, { "pgB", PG{ {  10.7, -60.7,  31.1 }, { .0, .0, .0 } } }
+			, { "pgC", PG{ {  30.7,  22.7, -61.3 }, { .0, .0, .0 } } }
+			};
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+
+		ConventionClasses const classes
+			{ ConventionClasses::from(keyGroups, allCons) };
+		std::size_t const expNumClasses{ ConventionOffset::theNumConventions };
+		std::size_t const gotNumClasses{ classes.numClasses() };
+		if (! (gotNumClasses == expNumClasses))
+		{
+			oss << "Failure of ConventionClasses numClasses test\n";
+			oss << "exp: " << expNumClasses << '\n';
+			oss << "got: " << gotNumClasses << '\n';
+		}
+		if (! (classes.numMembers() == allCons.size()))
+		{
+			oss << "Failure of ConventionClasses numMembers test\n";
+		}
+
+		// class evaluation should match exhaustive evaluation
+		std::map<SenKey, SenOri> const indKeyOris
+			{ om::sim::independentKeyOris
+				(om::sim::boxKeyOris(keyGroups, om::sim::sConventionA))
+			};
+		std::map<KeyPair, SenOri> const indKeyROs
+			{ relativeOrientationBetweens(indKeyOris) };
+		std::vector<double> const expSums
+			{ fitErrorByConvention(keyGroups, indKeyROs, allCons) };
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from(keyGroups, allCons) };
+		std::vector<double> const gotSums
+			{ fitErrorByConvention(boxTable, indKeyROs) };
+		if (! nearlyEqualFits(gotSums, expSums))
+		{
+			oss << "Failure of class BoxRelOriTable fit error test\n";
+			oss << "exp size: " << expSums.size() << '\n';
+			oss << "got size: " << gotSums.size() << '\n';
+		}
+	}
+
+	//! Check that class partition is not affected by ulp-level noise
+	void
+	testClassNoise
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+		using PG = ParmGroup;
+
+		// zero and equal magnitude angles (many conventions are alike)
+		std::map<SenKey, ParmGroup> const keyGroups
+			{ { "pgA", PG{ { -60.1,  10.3,  21.1 }, { .0, .0, .0 } } }
+			, { "pgB", PG{ {  10.7, -60.7,  31.1 }, { .5, -.5, .0 } } }
+			};
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyGroups) };
+		std::vector<AttitudeTable> const tables
+			{ attitudeTablesFor(registry, keyGroups) };
+		ConventionClasses const expClasses
+			{ ConventionClasses::from(tables, allCons) };
+
+		// value moved by (up to 2) ulps in a convention dependent way
+		auto const nudged
+			{ [] (double const & value, std::size_t const & cNdx)
+				{
+					double const toward{ (0u == (cNdx % 2u)) ? 1.e9 : -1.e9 };
+					double out{ value };
+					std::size_t numUlps{ cNdx % 3u };
+					while (0u < numUlps--)
+					{
+						out = std::nextafter(out, toward);
+					}
+					return out;
+				}
+			};
+
+		// partition (in first occurrence order) from noisy signatures
+		std::map<std::vector<double>, std::size_t> classForSigs;
+		std::vector<std::size_t> gotClassNdxs;
+		gotClassNdxs.reserve(allCons.size());
+		for (std::size_t cNdx{0u} ; cNdx < allCons.size() ; ++cNdx)
+		{
+			std::vector<double> signature;
+			for (AttitudeTable const & table : tables)
+			{
+				OriParts parts
+					{ OriParts::from(table.transformFor(allCons[cNdx])) };
+				parts.theSca = nudged(parts.theSca, cNdx);
+				for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+				{
+					parts.theBiv[kk] = nudged(parts.theBiv[kk], cNdx);
+					parts.theLoc[kk] = nudged(parts.theLoc[kk], cNdx);
+				}
+				ConventionClasses::appendSignature
+					( &signature
+					, parts.ori()
+					, ConventionClasses::quantumFor(table)
+					);
+			}
+			std::size_t const nextNdx{ classForSigs.size() };
+			gotClassNdxs.emplace_back
+				(classForSigs.emplace(signature, nextNdx).first->second);
+		}
+
+		if (! (expClasses.numClasses() < allCons.size()))
+		{
+			oss << "Failure of ConventionClasses noise test setup\n";
+			oss << "numClasses: " << expClasses.numClasses() << '\n';
+		}
+		if (! (gotClassNdxs == expClasses.theClassNdxs))
+		{
+			oss << "Failure of ConventionClasses noise test\n";
+			oss << "exp numClasses: " << expClasses.numClasses() << '\n';
+			oss << "got numClasses: " << classForSigs.size() << '\n';
+		}
+	}
+
+	//! Check that multi-threaded evaluation matches single thread result
+	void
+	testThreads
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		std::map<SenKey, SenOri> const indKeyOris
+			{ om::sim::independentKeyOris
+				(om::sim::boxKeyOris(keyGroups, om::sim::sConventionA))
+			};
+		std::map<KeyPair, SenOri> const indKeyROs
+			{ relativeOrientationBetweens(indKeyOris) };
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+
+		std::vector<double> const expSums
+			{ fitErrorByConvention(keyGroups, indKeyROs, allCons, 1u) };
+		// use a count that does not evenly divide number of conventions
+		constexpr std::size_t numThreads{ 5u };
+		std::vector<double> const gotSums
+			{ fitErrorByConvention(keyGroups, indKeyROs, allCons, numThreads) };
+		if (! (gotSums == expSums))
+		{
+			oss << "Failure of multi-thread fitErrorByConvention test\n";
+			oss << "numThreads: " << numThreads << '\n';
+		}
+
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from(keyGroups, allCons) };
+		std::vector<double> const gotTabSums
+			{ fitErrorByConvention(boxTable, indKeyROs, numThreads) };
+		if (! nearlyEqualFits(gotTabSums, expSums))
+		{
+			oss << "Failure of multi-thread BoxRelOriTable fit error test\n";
+			oss << "numThreads: " << numThreads << '\n';
+		}
+	}
+
+	//! Check two-stage search against brute force search
+	void
+	testRotationFirst
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyGroups = om::sim::sKeyGroups;
+		std::map<SenKey, SenOri> const indKeyOris
+			{ om::sim::independentKeyOris
+				(om::sim::boxKeyOris(keyGroups, om::sim::sConventionA))
+			};
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+
+		std::vector<FitNdxPair> const allFitNdxPairs
+			{ fitIndexPairsFor(keyGroups, indKeyOris, allCons) };
+		FitNdxPair const expBest
+			{ *std::min_element
+				(allFitNdxPairs.cbegin(), allFitNdxPairs.cend())
+			};
+
+		constexpr std::size_t numAngleCandidates{ 4u };
+		std::vector<FitNdxPair> const gotFitNdxPairs
+			{ fitIndexPairsRotationFirst
+				(keyGroups, indKeyOris, numAngleCandidates)
+			};
+
+		std::size_t const expSize{ numAngleCandidates * 96u };
+		if (! (gotFitNdxPairs.size() == expSize))
+		{
+			oss << "Failure of rotation first evaluation count test\n";
+			oss << "exp: " << expSize << '\n';
+			oss << "got: " << gotFitNdxPairs.size() << '\n';
+		}
+		else
+		{
+			FitNdxPair const gotBest
+				{ *std::min_element
+					(gotFitNdxPairs.cbegin(), gotFitNdxPairs.cend())
+				};
+			if (! (gotBest == expBest))
+			{
+				oss << "Failure of rotation first best solution test\n";
+				oss << "exp: " << infoString(expBest, allCons) << '\n';
+				oss << "got: " << infoString(gotBest, allCons) << '\n';
+			}
+
+			// each evaluated error should match brute force value
+			for (FitNdxPair const & gotPair : gotFitNdxPairs)
+			{
+				FitNdxPair const & expPair = allFitNdxPairs[gotPair.second];
+				if (! (gotPair == expPair))
+				{
+					oss << "Failure of rotation first fit value test\n";
+					oss << "exp: " << infoString(expPair, allCons) << '\n';
+					oss << "got: " << infoString(gotPair, allCons) << '\n';
+					break;
+				}
+			}
+		}
+
+		// selection: worst is a bound unless all conventions evaluated
+		std::map<SenKey, AttitudeTable> const keyTables
+			{ attitudeTablesFor(keyGroups) };
+		FitNdxSelector const gotSel
+			{ fitSelectionRotationFirst
+				(keyTables, indKeyOris, numAngleCandidates)
+			};
+		FitNdxSelector const allSel
+			{ fitSelectionRotationFirst
+				(keyTables, indKeyOris, ConventionAngle::theNumConventions)
+			};
+		if (! ( (gotSel.bests().front() == expBest)
+			 && gotSel.theIsWorstBound
+			 && (allCons.size() == allSel.theNumSeen)
+			 && (! allSel.theIsWorstBound)
+			  ) )
+		{
+			oss << "Failure of fitSelectionRotationFirst bound test\n";
+			oss << "gotSel bound: " << gotSel.theIsWorstBound << '\n';
+			oss << "allSel bound: " << allSel.theIsWorstBound << '\n';
+			oss << "allSel numSeen: " << allSel.theNumSeen << '\n';
+		}
+	}
+
 }
 
 //! Check convention recovery with simulated data
@@ -209,6 +1004,17 @@ main
 	std::stringstream oss;
 
 	testSim(oss);
+	testBasisMetric(oss);
+	testMetric(oss);
+	testSensorTransforms(oss);
+	testBoxTable(oss);
+	testClasses(oss);
+	testClassNoise(oss);
+	testSelector(oss);
+	testTrialOrder(oss);
+	testNear(oss);
+	testThreads(oss);
+	testRotationFirst(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
 	{
@@ -0,0 +1,253 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania::BoxCache
+*/
+
+
+#include "BoxCache.hpp"
+
+#include "Analysis.hpp"
+#include "Simulation.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! True if all members of table1 and table2 are identical
+	bool
+	sameTables
+		( om::BoxRelOriTable const & table1
+		, om::BoxRelOriTable const & table2
+		)
+	{
+		bool same
+			{  (table1.theNumConventions == table2.theNumConventions)
+			&& (table1.theClasses.theRepNdxs == table2.theClasses.theRepNdxs)
+			&& (table1.theClasses.theClassNdxs
+				== table2.theClasses.theClassNdxs)
+			&& (table1.theRegistry.theKeys == table2.theRegistry.theKeys)
+			&& (table1.thePairBoxROs.size() == table2.thePairBoxROs.size())
+			};
+		std::size_t const numSlots{ table1.thePairBoxROs.size() };
+		for (std::size_t nn{0u} ; same && (nn < numSlots) ; ++nn)
+		{
+			om::OriBatch const & batch1 = table1.thePairBoxROs[nn];
+			om::OriBatch const & batch2 = table2.thePairBoxROs[nn];
+			same =  (batch1.theScas == batch2.theScas)
+				&& (batch1.theBivs == batch2.theBivs)
+				&& (batch1.theLocs == batch2.theLocs);
+		}
+		return same;
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> const & keyBoxPGs = om::sim::sKeyGroups;
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyBoxPGs) };
+		std::vector<Convention> const allCons
+			{ Convention::allConventions() };
+		std::string const cachePath
+			{ (std::filesystem::temp_directory_path()
+				/ "test_BoxCache_test0.bin").string()
+			};
+		std::filesystem::remove(cachePath);
+
+		// [DoxyExample01]
+
+		// first use: table is computed and saved to file
+		bool fromCache1{ true };
+		BoxRelOriTable const table1
+			{ cachedBoxTable
+				(cachePath, registry, keyBoxPGs, allCons, &fromCache1)
+			};
+
+		// subsequent use (e.g. with other Ind data): loaded from file
+		bool fromCache2{ false };
+		BoxRelOriTable const table2
+			{ cachedBoxTable
+				(cachePath, registry, keyBoxPGs, allCons, &fromCache2)
+			};
+
+		// [DoxyExample01]
+
+		BoxRelOriTable const expTable
+			{ BoxRelOriTable::from
+				(registry, attitudeTablesFor(registry, keyBoxPGs), allCons)
+			};
+
+		if (! (fromCache2 && (! fromCache1)))
+		{
+			oss << "Failure of cachedBoxTable fromCache test\n";
+			oss << "exp: 0 1\n";
+			oss << "got: " << fromCache1 << ' ' << fromCache2 << '\n';
+		}
+		if (! sameTables(table1, expTable))
+		{
+			oss << "Failure of cachedBoxTable generated table test\n";
+		}
+		if (! sameTables(table2, expTable))
+		{
+			oss << "Failure of cachedBoxTable loaded table test\n";
+		}
+
+		std::filesystem::remove(cachePath);
+	}
+
+	//! Check that cache is not used for other data or damaged files
+	void
+	testStale
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, ParmGroup> keyBoxPGs = om::sim::sKeyGroups;
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyBoxPGs) };
+		std::vector<Convention> const allCons
+			{ Convention::allConventions() };
+		std::string const cachePath
+			{ (std::filesystem::temp_directory_path()
+				/ "test_BoxCache_testStale.bin").string()
+			};
+
+		std::uint64_t const key1
+			{ boxCacheKeyFor(registry, keyBoxPGs, allCons.size()) };
+		BoxRelOriTable const table1
+			{ BoxRelOriTable::from
+				(registry, attitudeTablesFor(registry, keyBoxPGs), allCons)
+			};
+		bool const saved{ saveBoxTable(cachePath, table1, key1) };
+		if (! saved)
+		{
+			oss << "Failure of saveBoxTable test\n";
+		}
+
+		// any change of Box data values changes key
+		keyBoxPGs.begin()->second.theDistances[1] += 1.e-12;
+		std::uint64_t const key2
+			{ boxCacheKeyFor(registry, keyBoxPGs, allCons.size()) };
+		if (key2 == key1)
+		{
+			oss << "Failure of boxCacheKeyFor change test\n";
+		}
+		BoxRelOriTable const gotStale
+			{ loadBoxTable(cachePath, registry, key2) };
+		if (! (0u == gotStale.theNumConventions))
+		{
+			oss << "Failure of loadBoxTable stale key test\n";
+		}
+
+		// file as saved is used (with its own key)
+		BoxRelOriTable const gotGood
+			{ loadBoxTable(cachePath, registry, key1) };
+		if (! sameTables(gotGood, table1))
+		{
+			oss << "Failure of loadBoxTable saved file test\n";
+		}
+
+		// but not if class indices are out of range (with valid header)
+		{
+			std::size_t numPairs{ 0u };
+			for (OriBatch const & batch : table1.thePairBoxROs)
+			{
+				if (! batch.empty())
+				{
+					++numPairs;
+				}
+			}
+			std::fstream ofs
+				(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+			ofs.seekp
+				(static_cast<std::streamoff>((6u + numPairs) * 8u));
+			std::uint64_t const badNdx{ table1.theClasses.numClasses() };
+			ofs.write(reinterpret_cast<char const *>(&badNdx), sizeof(badNdx));
+		}
+		BoxRelOriTable const gotBad
+			{ loadBoxTable(cachePath, registry, key1) };
+		if (! (0u == gotBad.theNumConventions))
+		{
+			oss << "Failure of loadBoxTable bad class index test\n";
+		}
+
+		// truncated file is not used
+		std::filesystem::resize_file
+			(cachePath, std::filesystem::file_size(cachePath) / 2u);
+		BoxRelOriTable const gotPart
+			{ loadBoxTable(cachePath, registry, key1) };
+		if (! (0u == gotPart.theNumConventions))
+		{
+			oss << "Failure of loadBoxTable truncated file test\n";
+		}
+
+		// nor is a missing one
+		std::filesystem::remove(cachePath);
+		BoxRelOriTable const gotNone
+			{ loadBoxTable(cachePath, registry, key1) };
+		if (! (0u == gotNone.theNumConventions))
+		{
+			oss << "Failure of loadBoxTable missing file test\n";
+		}
+	}
+
+}
+
+//! Check behavior of BoxCache
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testStale(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
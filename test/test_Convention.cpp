@@ -31,6 +31,8 @@
 #include "Convention.hpp"
 #include "io.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 #include <set>
@@ -103,6 +105,145 @@ namespace
 
 	}
 
+	//! Check packed identifier conversions
+	void
+	testConventionId
+		( std::ostream & oss
+		)
+	{
+		// conversions are available at compile time
+		constexpr om::ConventionId cxId{ 12345u };
+		constexpr om::Convention cxCon{ om::conventionFor(cxId) };
+		static_assert(cxId == om::conventionIdFor(cxCon), "conventionIdFor");
+		constexpr std::int64_t cxNum{ om::numberEncodingFor(cxId) };
+		static_assert
+			(cxId == om::conventionIdFromNumberEncoding(cxNum), "numId");
+
+		// identifiers should match positions in allConventions()
+		std::vector<om::Convention> const allCons
+			{ om::Convention::allConventions() };
+		for (std::size_t nn{0u} ; nn < allCons.size() ; ++nn)
+		{
+			om::Convention const & expCon = allCons[nn];
+			om::ConventionId const gotId{ om::conventionIdFor(expCon) };
+			om::Convention const gotCon{ om::conventionFor(gotId) };
+			std::int64_t const expNum{ expCon.numberEncoding() };
+			om::ConventionId const gotNumId
+				{ om::conventionIdFromNumberEncoding(expNum) };
+			if (! ((nn == gotId) && (gotCon == expCon) && (gotNumId == gotId)))
+			{
+				oss << "Failure of ConventionId conversion test\n";
+				oss << "exp: " << nn << ' ' << expCon << '\n';
+				oss << "got: " << gotId << ' ' << gotCon << '\n';
+				oss << "gotNumId: " << gotNumId << '\n';
+				break;
+			}
+		}
+
+		// invalid conventions and numbers
+		om::Convention const nullCon{};
+		std::int64_t const badNum{ 1000000000000 }; // indices "000"
+		if (! (  (om::sNullConventionId == om::conventionIdFor(nullCon))
+			  && (om::sNullConventionId
+				== om::conventionIdFromNumberEncoding(badNum))
+			  && (-1 == om::numberEncodingFor(om::sNullConventionId))
+			  && (! om::conventionFor(om::sNullConventionId).isValid())
+			  ))
+		{
+			oss << "Failure of invalid ConventionId test\n";
+		}
+
+		// malformed fields (e.g. from text) have no identifier
+		// (fields in ConventionString::convention() order)
+		auto const conFrom
+			{ [] (std::string_view const & text)
+				{ return om::ConventionString::from(text).convention(); }
+			};
+		om::Convention const badNdxs{ conFrom("+++ 000 +++ 000 000 0") };
+		om::Convention const badBivs{ conFrom("+++ 012 +++ 012 333 0") };
+		om::Convention const badSigns{ conFrom("+?+ 012 +++ 012 010 0") };
+		om::Convention const goodCon{ conFrom("+++ 012 +++ 012 010 0") };
+		if (! (  (om::sNullConventionId == om::conventionIdFor(badNdxs))
+			  && (om::sNullConventionId == om::conventionIdFor(badBivs))
+			  && (om::sNullConventionId == om::conventionIdFor(badSigns))
+			  && (om::sNullConventionId != om::conventionIdFor(goodCon))
+			  ))
+		{
+			oss << "Failure of malformed Convention identifier test\n";
+			oss << "badNdxs: " << om::conventionIdFor(badNdxs) << '\n';
+			oss << "badBivs: " << om::conventionIdFor(badBivs) << '\n';
+			oss << "badSigns: " << om::conventionIdFor(badSigns) << '\n';
+		}
+
+		// malformed conventions remain distinct (and sort after valid)
+		std::set<om::Convention> const conSet
+			{ badNdxs, badBivs, badSigns, goodCon, nullCon };
+		if (! ((5u == conSet.size()) && (goodCon == *(conSet.begin()))))
+		{
+			oss << "Failure of malformed Convention ordering test\n";
+			oss << "conSet.size(): " << conSet.size() << '\n';
+		}
+	}
+
+	//! Check compile-time table against combinations of all parts
+	void
+	testTable
+		( std::ostream & oss
+		)
+	{
+		std::array<om::Convention, om::Convention::theNumConventions>
+			const & table = om::Convention::allConventionTable();
+
+		// brute force generation of all combinations (outer to inner)
+		std::vector<om::Convention> expCons;
+		expCons.reserve(table.size());
+		for (om::ThreeSigns const & offSign : om::allThreeSigns())
+		{
+			for (om::ThreeIndices const & offNdx : om::allThreeIndices())
+			{
+				for (om::ThreeSigns const & angSign : om::allThreeSigns())
+				{
+					for (om::ThreeIndices const & angNdx
+						: om::allThreeIndices())
+					{
+						for (om::ThreeIndices const & bivNdx
+							: om::allBivIndices())
+						{
+							for (om::OrderTR const & order : om::allOrderTRs())
+							{
+								expCons.emplace_back
+									( om::Convention
+										{ om::ConventionOffset
+											{ offSign, offNdx }
+										, om::ConventionAngle
+											{ angSign, angNdx, bivNdx }
+										, order
+										}
+									);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		std::vector<om::Convention> const gotCons
+			{ om::Convention::allConventions() };
+		bool okay{ (expCons.size() == table.size()) };
+		for (std::size_t nn{0u} ; okay && (nn < expCons.size()) ; ++nn)
+		{
+			om::Convention const & expCon = expCons[nn];
+			okay = ((expCon == table[nn]) && (expCon == gotCons[nn]));
+			if (! okay)
+			{
+				oss << "Failure of allConventionTable test\n";
+				oss << "nn: " << nn << '\n';
+				oss << "exp: " << expCon << '\n';
+				oss << "got: " << table[nn] << '\n';
+			}
+		}
+	}
+
 	//! Check key generation for conventions
 	void
 	testKeys
@@ -222,6 +363,105 @@ namespace
 		}
 	}
 
+	//! Check precomputed attitudes against individually computed ones
+	void
+	testAttitudeTable
+		( std::ostream & oss
+		)
+	{
+		// check that index values match position in allConventions()
+		std::vector<om::ConventionAngle> const angConvs
+			{ om::ConventionAngle::allConventions() };
+		for (std::size_t nn{0u} ; nn < angConvs.size() ; ++nn)
+		{
+			std::size_t const gotNdx{ angConvs[nn].indexValue() };
+			if (! (nn == gotNdx))
+			{
+				oss << "Failure of ConventionAngle indexValue test\n";
+				oss << "exp: " << nn << '\n';
+				oss << "got: " << gotNdx << '\n';
+				break;
+			}
+		}
+
+		// check index values for (full) conventions
+		std::vector<om::Convention> const allCons
+			{ om::Convention::allConventions() };
+		for (std::size_t nn{0u} ; nn < allCons.size() ; ++nn)
+		{
+			std::size_t const gotNdx{ allCons[nn].indexValue() };
+			if (! (nn == gotNdx))
+			{
+				oss << "Failure of Convention indexValue test\n";
+				oss << "exp: " << nn << '\n';
+				oss << "got: " << gotNdx << '\n';
+				break;
+			}
+		}
+
+		om::ParmGroup const parmGroup
+			{ om::ThreeDistances{ 10., -30., 20. }
+			, om::ThreeAngles{ -.7, .3, -.5 }
+			};
+		om::AttitudeTable const table{ om::AttitudeTable::from(parmGroup) };
+		if (! table.isValid())
+		{
+			oss << "Failure of AttitudeTable validity test\n";
+			oss << "exp: " << om::ConventionAngle::theNumConventions << '\n';
+			oss << "got: " << table.theAtts.size() << '\n';
+		}
+		else
+		{
+			// table attitudes should match direct computation (roundoff)
+			constexpr double tol{ 1.e-14 };
+			for (std::size_t nn{0u} ; nn < angConvs.size() ; ++nn)
+			{
+				om::Convention const convention
+					{ om::ConventionOffset{}, angConvs[nn], om::TranRot };
+				engabra::g3::Spinor const expSpin
+					{ convention.attitudeFor(parmGroup).spinor() };
+				engabra::g3::Spinor const gotSpin
+					{ table.theAtts[nn].spinor() };
+				double maxDiff
+					{ std::abs(gotSpin.theSca[0] - expSpin.theSca[0]) };
+				for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+				{
+					maxDiff = std::max
+						( maxDiff
+						, std::abs(gotSpin.theBiv[kk] - expSpin.theBiv[kk])
+						);
+				}
+				if (! (maxDiff < tol))
+				{
+					oss << "Failure of AttitudeTable attitude test\n";
+					oss << "convention: " << convention << '\n';
+					oss << "exp: " << expSpin << '\n';
+					oss << "got: " << gotSpin << '\n';
+					break;
+				}
+			}
+
+			// table transforms should match direct computation
+			std::vector<om::Convention> const conventions
+				{ om::Convention::allConventions() };
+			for (om::Convention const & convention : conventions)
+			{
+				rigibra::Transform const expXfm
+					{ convention.transformFor(parmGroup) };
+				rigibra::Transform const gotXfm
+					{ table.transformFor(convention) };
+				if (! nearlyEquals(gotXfm, expXfm))
+				{
+					oss << "Failure of AttitudeTable transform test\n";
+					oss << "convention: " << convention << '\n';
+					oss << "exp: " << expXfm << '\n';
+					oss << "got: " << gotXfm << '\n';
+					break;
+				}
+			}
+		}
+	}
+
 	//! Check string en/de-coding of conventions
 	void
 	testEncode
@@ -249,6 +489,35 @@ namespace
 			oss << "convention: " << convention << '\n';
 			oss << "cs2: " << cs2.stringEncoding() << '\n';
 		}
+
+		// fixed size encoding same as string encoding (for all)
+		std::size_t numDiffs{ 0u };
+		std::size_t numBadDecodes{ 0u };
+		for (om::Convention const & conv : om::Convention::allConventions())
+		{
+			om::ConventionText const text{ om::ConventionText::from(conv) };
+			std::string const expText
+				{ om::ConventionString::from(conv).stringEncoding() };
+			if (! (text.view() == expText))
+			{
+				++numDiffs;
+			}
+			om::ConventionId const expId{ om::conventionIdFor(conv) };
+			om::Convention const decoded{ text.convention() };
+			if (! ( (om::conventionIdFor(decoded) == expId)
+				 && (text.conventionId() == expId)
+				 && (om::ConventionText::from(decoded).view() == text.view())
+				  ) )
+			{
+				++numBadDecodes;
+			}
+		}
+		if (! ((0u == numDiffs) && (0u == numBadDecodes)))
+		{
+			oss << "Failure of ConventionText encoding test\n";
+			oss << "numDiffs: " << numDiffs << '\n';
+			oss << "numBadDecodes: " << numBadDecodes << '\n';
+		}
 	}
 
 }
@@ -263,8 +532,11 @@ main
 
 	testPermuations(oss);
 	testNumId(oss);
+	testConventionId(oss);
+	testTable(oss);
 	testKeys(oss);
 	testTransforms(oss);
+	testAttitudeTable(oss);
 	testEncode(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
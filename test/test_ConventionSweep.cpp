@@ -0,0 +1,373 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Self-consistency sweep: simulate and solve for each Box convention.
+
+For each Box convention (in a range of ConventionId values) Ind data
+are simulated (ref om::sim::Payload) and the fit errors of all of the
+Box conventions are evaluated. The simulated convention should be
+recovered, i.e. it should have (near) zero fit error. Any other
+conventions that also fit within tolerance are indistinguishable from
+it (for the simulated data) and are reported as well.
+
+Without arguments, a small range is checked as a unit test. With
+arguments, results are written to a file, one line per convention:
+\arg <convId> <isRecovered> <numMatch> <matchId> <matchId> ...
+
+Conventions already in the file are skipped, such that an interrupted
+sweep resumes where it stopped. E.g. for all conventions:
+\code
+test_ConventionSweep 0 55296 sweep.txt 8
+\endcode
+*/
+
+
+#include "Simulation.hpp"
+
+#include "OriMania.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	//! Sweep configuration (from command line arguments).
+	struct SweepConfig
+	{
+		std::size_t theBegId{ 0u };
+		std::size_t theEndId{ 96u }; // small range for unit test
+		std::filesystem::path theOutPath{}; // empty: no output (test)
+		std::size_t theNumThreads{ 1u };
+		std::size_t theNumSensors{ 7u };
+		double theTolerance{ 1.e-6 };
+
+		//! Configuration from arguments (false if they are not valid)
+		inline
+		static
+		bool
+		from
+			( int const argc
+			, char * argv[]
+			, SweepConfig * const & ptConfig
+			)
+		{
+			bool okay{ (1 == argc) || ((4 <= argc) && (argc <= 6)) };
+			if (okay && (1 < argc))
+			{
+				SweepConfig & config = *ptConfig;
+				config.theBegId = std::stoul(argv[1]);
+				config.theEndId = std::min
+					( static_cast<std::size_t>(std::stoul(argv[2]))
+					, om::Convention::theNumConventions
+					);
+				config.theOutPath = argv[3];
+				if (4 < argc)
+				{
+					config.theNumThreads = std::stoul(argv[4]);
+				}
+				if (5 < argc)
+				{
+					config.theNumSensors = std::stoul(argv[5]);
+				}
+				okay =
+					(  (config.theBegId < config.theEndId)
+					&& (0u < config.theNumThreads)
+					&& (1u < config.theNumSensors)
+					);
+			}
+			return okay;
+		}
+
+	}; // SweepConfig
+
+	//! Outcome for one simulated Box convention.
+	struct SweepResult
+	{
+		//! Simulated (ground truth) Box convention.
+		om::ConventionId theConvId{ om::sNullConventionId };
+
+		//! True if the simulated convention fits within tolerance.
+		bool theIsRecovered{ false };
+
+		//! All conventions that fit within tolerance (in id order).
+		std::vector<om::ConventionId> theMatchIds{};
+
+		//! True if recovered and no other convention fits as well.
+		inline
+		bool
+		isUnique
+			() const
+		{
+			return (theIsRecovered && (1u == theMatchIds.size()));
+		}
+
+		//! Output line (without newline) - ref file description.
+		inline
+		std::string
+		infoString
+			() const
+		{
+			std::ostringstream oss;
+			oss << theConvId
+				<< ' ' << theIsRecovered
+				<< ' ' << theMatchIds.size();
+			for (om::ConventionId const & matchId : theMatchIds)
+			{
+				oss << ' ' << matchId;
+			}
+			return oss.str();
+		}
+
+	}; // SweepResult
+
+	/*! \brief Simulate data for convId and find all conventions that fit.
+	 *
+	 * The boxTable must be from the Box ParmGroups of a payload from
+	 * spec (these are the same for all theBoxConvId values).
+	 */
+	inline
+	SweepResult
+	sweepResultFor
+		( om::BoxRelOriTable const & boxTable
+		, om::sim::PayloadSpec const & spec
+		, om::ConventionId const & convId
+		, double const & tolerance
+		)
+	{
+		using namespace om;
+
+		SweepResult result;
+		result.theConvId = convId;
+
+		sim::PayloadSpec convSpec{ spec };
+		convSpec.theBoxConvId = convId;
+		sim::Payload const payload{ sim::Payload::from(convSpec) };
+
+		std::vector<NdxRelOri> const indROs
+			{ indRelOrisFor
+				( attitudeTablesFor(boxTable.theRegistry, payload.theIndKeyPGs)
+				, payload.theIndConvention
+				)
+			};
+		std::vector<double> const sumClassErrors
+			{ fitErrorByClass(boxTable, indROs) };
+
+		// classes that fit within tolerance (normalized as for fits)
+		double const scale{ 1. / static_cast<double>(indROs.size()) };
+		std::vector<bool> isMatchClass(sumClassErrors.size(), false);
+		for (std::size_t clNdx{0u} ; clNdx < sumClassErrors.size() ; ++clNdx)
+		{
+			isMatchClass[clNdx] = (scale * sumClassErrors[clNdx] < tolerance);
+		}
+
+		// conventions in those classes
+		std::vector<std::size_t> const & classNdxs
+			= boxTable.theClasses.theClassNdxs;
+		for (std::size_t cNdx{0u} ; cNdx < classNdxs.size() ; ++cNdx)
+		{
+			if (isMatchClass[classNdxs[cNdx]])
+			{
+				result.theMatchIds.emplace_back
+					(static_cast<ConventionId>(cNdx));
+			}
+		}
+		result.theIsRecovered = isMatchClass[classNdxs[convId]];
+
+		return result;
+	}
+
+	/*! \brief Convention ids already in (complete lines of) outPath.
+	 *
+	 * Any incomplete last line (e.g. from an interrupted sweep) is
+	 * removed from the file such that new lines may be appended.
+	 */
+	inline
+	std::set<om::ConventionId>
+	doneIdsFrom
+		( std::filesystem::path const & outPath
+		)
+	{
+		std::set<om::ConventionId> doneIds;
+		if (std::filesystem::exists(outPath))
+		{
+			std::string text;
+			{
+				std::ifstream ifs(outPath, std::ios::binary);
+				std::ostringstream oss;
+				oss << ifs.rdbuf();
+				text = oss.str();
+			}
+			std::size_t const endComplete{ text.rfind('\n') + 1u };
+			if (endComplete < text.size())
+			{
+				std::filesystem::resize_file(outPath, endComplete);
+			}
+			std::istringstream iss(text.substr(0u, endComplete));
+			std::string line;
+			while (std::getline(iss, line))
+			{
+				std::istringstream issLine(line);
+				std::size_t convId{ om::sNullConventionId };
+				issLine >> convId;
+				if ((! issLine.fail()) && (convId < om::sNullConventionId))
+				{
+					doneIds.insert(static_cast<om::ConventionId>(convId));
+				}
+			}
+		}
+		return doneIds;
+	}
+
+} // [anon]
+
+//! Check that simulated conventions are recovered (or run a sweep).
+int
+main
+	( int argc
+	, char * argv[]
+	)
+{
+	SweepConfig config;
+	if (! SweepConfig::from(argc, argv, &config))
+	{
+		std::cerr << '\n' << argv[0] << " Bad invocation:"
+			"\nUsage:"
+			"\n  <ProgName> [<BegId> <EndId> <OutPath>"
+				" [NumThreads [NumSensors]]]"
+			"\n"
+			"\n  Without arguments: unit test over a small range"
+			"\n  <BegId> <EndId> : Range of Box ConventionId values"
+				" (e.g. 0 55296)"
+			"\n  <OutPath> : Result file (appended - an interrupted"
+				" sweep resumes)"
+			"\n\n"
+			;
+		return 1;
+	}
+
+	using namespace om;
+
+	int status{ 1 };
+	std::stringstream oss;
+
+	// Box data are the same for every simulated convention
+	sim::PayloadSpec spec;
+	spec.theNumSensors = config.theNumSensors;
+	spec.theSeed = 55296u;
+	sim::Payload const payload{ sim::Payload::from(spec) };
+	SenRegistry const registry
+		{ SenRegistry::fromKeysOf(payload.theBoxKeyPGs, payload.theIndKeyPGs) };
+	BoxRelOriTable const boxTable
+		{ BoxRelOriTable::from
+			( registry
+			, attitudeTablesFor(registry, payload.theBoxKeyPGs)
+			, Convention::allConventions()
+			)
+		};
+
+	// conventions remaining (those in an existing output are done)
+	std::set<ConventionId> doneIds;
+	if (! config.theOutPath.empty())
+	{
+		doneIds = doneIdsFrom(config.theOutPath);
+	}
+	std::vector<ConventionId> todoIds;
+	for (std::size_t convId{config.theBegId} ; convId < config.theEndId
+		; ++convId)
+	{
+		if (doneIds.end() == doneIds.find(static_cast<ConventionId>(convId)))
+		{
+			todoIds.emplace_back(static_cast<ConventionId>(convId));
+		}
+	}
+
+	// evaluate conventions concurrently (saving each result when done)
+	std::ofstream ofsOut;
+	if (! config.theOutPath.empty())
+	{
+		ofsOut.open(config.theOutPath, std::ios::app);
+	}
+	std::mutex outMutex;
+	std::size_t numNotRecovered{ 0u };
+	std::size_t numNotUnique{ 0u };
+	auto const sweepOne
+		{ [&]
+			( std::size_t const todoNdx
+			)
+		{
+			SweepResult const result
+				{ sweepResultFor
+					(boxTable, spec, todoIds[todoNdx], config.theTolerance)
+				};
+			std::string const line{ result.infoString() };
+			std::lock_guard<std::mutex> const lock(outMutex);
+			if (! result.theIsRecovered)
+			{
+				++numNotRecovered;
+				oss << "Failure to recover simulated convention: "
+					<< line << '\n';
+			}
+			if (! result.isUnique())
+			{
+				++numNotUnique;
+			}
+			if (ofsOut.is_open())
+			{
+				ofsOut << line << '\n' << std::flush;
+			}
+		}
+		};
+	par::forEachIndex(todoIds.size(), config.theNumThreads, sweepOne);
+
+	if (! config.theOutPath.empty())
+	{
+		std::cout
+			<< "# conventions done previously: " << doneIds.size() << '\n'
+			<< "# conventions evaluated: " << todoIds.size() << '\n'
+			<< "# not recovered: " << numNotRecovered << '\n'
+			<< "# not unique: " << numNotUnique << '\n';
+	}
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
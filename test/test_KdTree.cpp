@@ -0,0 +1,161 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania::KdTree
+*/
+
+
+#include "KdTree.hpp"
+
+#include <array>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// [DoxyExample01]
+
+		// a few points in 2D
+		using Point = KdTree<2u>::Point;
+		std::vector<Point> const points
+			{ Point{ 0., 0. }
+			, Point{ 1., 0. }
+			, Point{ 0., 1. }
+			, Point{ 1., 1. }
+			, Point{ 5., 5. }
+			};
+		KdTree<2u> const tree{ KdTree<2u>::from(points) };
+
+		// indices (into points) of those within radius of query
+		std::vector<std::size_t> const gotNdxs
+			{ tree.indicesWithin(Point{ .9, .9 }, 1.) };
+		// expect points at indices 1, 2 and 3
+
+		// [DoxyExample01]
+
+		std::vector<std::size_t> const expNdxs{ 1u, 2u, 3u };
+		if (! (gotNdxs == expNdxs))
+		{
+			oss << "Failure of KdTree example test\n";
+			oss << "exp size: " << expNdxs.size() << '\n';
+			oss << "got size: " << gotNdxs.size() << '\n';
+		}
+	}
+
+	//! Check queries against brute force search
+	void
+	testQueries
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+		using Point = KdTree<7u>::Point;
+
+		// pseudo-random (but repeatable) points
+		std::mt19937 gen(47u);
+		std::uniform_real_distribution<double> dist(-1., 1.);
+		std::vector<Point> points(2000u);
+		for (Point & point : points)
+		{
+			for (double & value : point)
+			{
+				value = dist(gen);
+			}
+		}
+		// include some duplicate coordinates
+		points[7u] = points[3u];
+		points[11u][0] = points[3u][0];
+
+		KdTree<7u> const tree{ KdTree<7u>::from(points) };
+		if (! (points.size() == tree.size()))
+		{
+			oss << "Failure of KdTree size test\n";
+		}
+
+		std::vector<double> const radii{ 0., .25, .75, 1.5 };
+		for (std::size_t qq{0u} ; qq < 25u ; ++qq)
+		{
+			Point const & query = points[qq];
+			for (double const & radius : radii)
+			{
+				std::vector<std::size_t> expNdxs;
+				for (std::size_t nn{0u} ; nn < points.size() ; ++nn)
+				{
+					if (! ((radius*radius) < tree.distSq(query, points[nn])))
+					{
+						expNdxs.emplace_back(nn);
+					}
+				}
+				std::vector<std::size_t> const gotNdxs
+					{ tree.indicesWithin(query, radius) };
+				if (! (gotNdxs == expNdxs))
+				{
+					oss << "Failure of KdTree query test\n";
+					oss << "query: " << qq << " radius: " << radius << '\n';
+					oss << "exp size: " << expNdxs.size() << '\n';
+					oss << "got size: " << gotNdxs.size() << '\n';
+				}
+			}
+		}
+	}
+
+}
+
+//! Check behavior of KdTree
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testQueries(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,223 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania::OriBatch
+*/
+
+
+#include "OriBatch.hpp"
+
+#include "Analysis.hpp"
+
+#include <Engabra>
+#include <Rigibra>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! A few (diverse) orientations
+	std::vector<om::SenOri>
+	someOris
+		()
+	{
+		using namespace rigibra;
+		using engabra::g3::BiVector;
+		return std::vector<om::SenOri>
+			{ om::SenOri{ Location{ 0., 0., 0. }
+				, Attitude{ PhysAngle{ BiVector{ .3, 0., 0. } } } }
+			, om::SenOri{ Location{ 1., -2., 3. }
+				, Attitude{ PhysAngle{ BiVector{ 0., 0., 0. } } } }
+			, om::SenOri{ Location{ 1., 2., 3. }
+				, Attitude{ PhysAngle{ BiVector{ .5, -.7, .2 } } } }
+			, om::SenOri{ Location{ -.5, 9., .1 }
+				, Attitude{ PhysAngle{ BiVector{ -2., 1., 3. } } } }
+			, om::SenOri{ Location{ 7., -3., 2. }
+				, Attitude{ PhysAngle{ BiVector{ 1.1, .4, -.9 } } } }
+			};
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::vector<SenOri> const oris1{ someOris() };
+		std::vector<SenOri> const oris2(oris1.crbegin(), oris1.crend());
+
+		// [DoxyExample01]
+
+		// orientations in structure-of-arrays form
+		OriBatch const batch1{ OriBatch::from(oris1) };
+		OriBatch const batch2{ OriBatch::from(oris2) };
+
+		// batch (vectorized) operations
+		OriBatch const gotInvs{ inverseOf(batch1) };
+		OriBatch const gotComps{ composedOf(batch2, batch1) };
+
+		// fit errors of each batch1 element with respect to oris2[0]
+		std::vector<double> gotSums(batch1.size(), 0.);
+		OriParts const parts2{ OriParts::from(oris2[0]) };
+		addRmseRotorErrors
+			(gotSums.data(), batch1, parts2, 0u, batch1.size());
+
+		// [DoxyExample01]
+
+		if (! (oris1.size() == batch1.size()))
+		{
+			oss << "Failure of OriBatch size test\n";
+			oss << "exp: " << oris1.size() << '\n';
+			oss << "got: " << batch1.size() << '\n';
+		}
+
+		for (std::size_t nn{0u} ; nn < oris1.size() ; ++nn)
+		{
+			// round trip
+			SenOri const & expOri = oris1[nn];
+			SenOri const gotOri{ batch1.oriAt(nn) };
+			if (! nearlyEquals(gotOri, expOri))
+			{
+				oss << "Failure of OriBatch oriAt test\n";
+				oss << "exp: " << expOri << '\n';
+				oss << "got: " << gotOri << '\n';
+			}
+
+			// inverse
+			SenOri const expInv{ inverse(oris1[nn]) };
+			SenOri const gotInv{ gotInvs.oriAt(nn) };
+			if (! nearlyEquals(gotInv, expInv))
+			{
+				oss << "Failure of inverseOf test\n";
+				oss << "exp: " << expInv << '\n';
+				oss << "got: " << gotInv << '\n';
+			}
+
+			// composition
+			SenOri const expComp{ oris2[nn] * oris1[nn] };
+			SenOri const gotComp{ gotComps.oriAt(nn) };
+			if (! nearlyEquals(gotComp, expComp))
+			{
+				oss << "Failure of composedOf test\n";
+				oss << "exp: " << expComp << '\n';
+				oss << "got: " << gotComp << '\n';
+			}
+
+			// fit metric: exactly as single element (non batch) function
+			double const expSum
+				{ rmseRotorBetween(batch1.partsAt(nn), parts2) };
+			double const & gotSum = gotSums[nn];
+			if (! (gotSum == expSum))
+			{
+				oss << "Failure of addRmseRotorErrors exact test\n";
+				oss << "exp: " << expSum << '\n';
+				oss << "got: " << gotSum << '\n';
+			}
+
+			// and (nearly) as with basis vector transformation
+			double const expBasis
+				{ om::rmseBasisErrorBetween(oris1[nn], oris2[0]) };
+			if (! engabra::g3::nearlyEquals(gotSum, expBasis))
+			{
+				oss << "Failure of addRmseRotorErrors basis test\n";
+				oss << "exp: " << expBasis << '\n';
+				oss << "got: " << gotSum << '\n';
+			}
+		}
+	}
+
+	//! Check partial range accumulation (e.g. for blocks and remainders)
+	void
+	testRange
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// long enough to have vector body and scalar remainder
+		std::vector<SenOri> oris;
+		for (std::size_t nn{0u} ; nn < 9u ; ++nn)
+		{
+			std::vector<SenOri> const some{ someOris() };
+			oris.insert(oris.end(), some.cbegin(), some.cend());
+		}
+		OriBatch const batch{ OriBatch::from(oris) };
+		OriParts const parts2{ OriParts::from(oris[3]) };
+
+		std::size_t const ndxBeg{ 3u };
+		std::size_t const ndxEnd{ oris.size() - 2u };
+		std::vector<double> gotSums(oris.size(), 1.);
+		addRmseRotorErrors(gotSums.data(), batch, parts2, ndxBeg, ndxEnd);
+
+		for (std::size_t nn{0u} ; nn < oris.size() ; ++nn)
+		{
+			double expSum{ 1. };
+			if ((ndxBeg <= nn) && (nn < ndxEnd))
+			{
+				expSum += rmseRotorBetween(batch.partsAt(nn), parts2);
+			}
+			double const & gotSum = gotSums[nn];
+			if (! (gotSum == expSum))
+			{
+				oss << "Failure of addRmseRotorErrors range test\n";
+				oss << "nn: " << nn << '\n';
+				oss << "exp: " << expSum << '\n';
+				oss << "got: " << gotSum << '\n';
+			}
+		}
+	}
+
+}
+
+//! Check behavior of OriBatch
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testRange(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
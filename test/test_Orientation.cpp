@@ -68,6 +68,61 @@ namespace
 		}
 	}
 
+	//! Check interning of sensor keys
+	void
+	testRegistry
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::map<SenKey, double> const keyValsA
+			{ { "keyC", 3. }, { "keyA", 1. } };
+		std::map<SenKey, int> const keyValsB
+			{ { "keyB", 2 }, { "keyC", 3 } };
+		SenRegistry const registry
+			{ SenRegistry::fromKeysOf(keyValsA, keyValsB) };
+
+		// unique keys in sorted order
+		std::vector<SenKey> const expKeys{ "keyA", "keyB", "keyC" };
+		if (! (registry.theKeys == expKeys))
+		{
+			oss << "Failure of SenRegistry keys test\n";
+		}
+		for (SenNdx ndx{0u} ; ndx < expKeys.size() ; ++ndx)
+		{
+			if (! ( (ndx == registry.ndxFor(expKeys[ndx]))
+				 && (expKeys[ndx] == registry.keyFor(ndx))
+				 ))
+			{
+				oss << "Failure of SenRegistry ndxFor/keyFor test\n";
+				oss << "ndx: " << ndx << '\n';
+			}
+		}
+		if (! (SenRegistry::sNullNdx == registry.ndxFor("keyD")))
+		{
+			oss << "Failure of SenRegistry null index test\n";
+		}
+
+		// dense values (with fill for keys not in map)
+		std::vector<double> const expVals{ 1., -1., 3. };
+		std::vector<double> const gotVals
+			{ registry.denseFrom(keyValsA, -1.) };
+		if (! (gotVals == expVals))
+		{
+			oss << "Failure of SenRegistry denseFrom test\n";
+		}
+
+		// comparison of key pairs
+		KeyPair const pairAB{ "keyA", "keyB" };
+		KeyPair const pairAC{ "keyA", "keyC" };
+		KeyPair const pairBA{ "keyB", "keyA" };
+		if (! ((pairAB < pairAC) && (pairAC < pairBA) && (! (pairAB < pairAB))))
+		{
+			oss << "Failure of KeyPair operator< test\n";
+		}
+	}
+
 	//! Examples for documentation
 	void
 	testRelOrientations
@@ -152,6 +207,79 @@ namespace
 		}
 	}
 
+
+	//! Check flat (indexed) RO collection against keyed ROs
+	void
+	testFlatROs
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// orientations for several sensors
+		std::map<SenKey, SenOri> keyOris;
+		using namespace rigibra;
+		for (std::size_t nn{0u} ; nn < 7u ; ++nn)
+		{
+			double const dd{ static_cast<double>(nn) };
+			SenOri const ori
+				{ Location{ 1. + dd, -2. * dd, .5 * dd }
+				, Attitude(PhysAngle{ .1 * dd, -.2 + .05 * dd, .3 })
+				};
+			keyOris.emplace_hint
+				(keyOris.end(), std::make_pair(keyFrom(nn), ori));
+		}
+		std::map<KeyPair, SenOri> const keyROs
+			{ relativeOrientationBetweens(keyOris) };
+
+		SenRegistry const registry{ SenRegistry::fromKeysOf(keyOris) };
+		std::vector<SenOri> const oris
+			{ registry.denseFrom(keyOris, SenOri{}) };
+		constexpr std::size_t numThreads{ 3u };
+		std::vector<NdxRelOri> const gotROs
+			{ relativeOrientationBetweens(oris, numThreads) };
+		std::vector<NdxRelOri> const expROs
+			{ ndxRelOrisFor(registry, keyROs) };
+
+		if (! (gotROs.size() == expROs.size()))
+		{
+			oss << "Failure of flat RO size test\n";
+			oss << "exp: " << expROs.size() << '\n';
+			oss << "got: " << gotROs.size() << '\n';
+		}
+		else
+		{
+			for (std::size_t nn{0u} ; nn < expROs.size() ; ++nn)
+			{
+				NdxRelOri const & expRO = expROs[nn];
+				NdxRelOri const & gotRO = gotROs[nn];
+				if (! ( (gotRO.theNdx1 == expRO.theNdx1)
+					 && (gotRO.theNdx2 == expRO.theNdx2)
+					 && nearlyEquals(gotRO.theRelOri, expRO.theRelOri)
+					 ))
+				{
+					oss << "Failure of flat RO value test\n";
+					oss << "nn: " << nn << '\n';
+					oss << "exp: " << expRO.theRelOri << '\n';
+					oss << "got: " << gotRO.theRelOri << '\n';
+					break;
+				}
+			}
+		}
+
+		// subset of sensors
+		std::vector<SenNdx> const senNdxs{ 1u, 4u, 5u };
+		std::vector<NdxRelOri> const subROs
+			{ relativeOrientationBetweens(oris, senNdxs, numThreads) };
+		if (! ( (3u == subROs.size())
+			 && (1u == subROs[1].theNdx1) && (5u == subROs[1].theNdx2)
+			 && (4u == subROs[2].theNdx1) && (5u == subROs[2].theNdx2)
+			 ))
+		{
+			oss << "Failure of flat RO subset test\n";
+		}
+	}
+
 }
 
 //! Check behavior of Orientation operations
@@ -163,7 +291,9 @@ main
 	std::stringstream oss;
 
 	test0(oss);
+	testRegistry(oss);
 	testRelOrientations(oss);
+	testFlatROs(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
 	{
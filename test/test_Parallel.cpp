@@ -0,0 +1,155 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania om::par functions
+*/
+
+
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Check that blocks cover all items exactly once
+	void
+	testBlocks
+		( std::ostream & oss
+		)
+	{
+		constexpr std::size_t numItems{ 1001u };
+		for (std::size_t numThreads{1u} ; numThreads < 9u ; ++numThreads)
+		{
+			// [DoxyExample01]
+
+			// each block increments the counts within its own range
+			std::vector<int> counts(numItems, 0);
+			om::par::forEachBlock
+				( numItems
+				, numThreads
+				, [&counts]
+					( std::size_t const ndxBeg
+					, std::size_t const ndxEnd
+					)
+					{
+						for (std::size_t ndx{ndxBeg} ; ndx < ndxEnd ; ++ndx)
+						{
+							++counts[ndx];
+						}
+					}
+				);
+
+			// [DoxyExample01]
+
+			std::vector<int> const expCounts(numItems, 1);
+			if (! (counts == expCounts))
+			{
+				oss << "Failure of forEachBlock coverage test\n";
+				oss << "numThreads: " << numThreads << '\n';
+				break;
+			}
+		}
+	}
+
+	//! Check that pool processes all items exactly once
+	void
+	testPool
+		( std::ostream & oss
+		)
+	{
+		constexpr std::size_t numItems{ 1001u };
+		for (std::size_t numThreads{1u} ; numThreads < 9u ; ++numThreads)
+		{
+			std::vector<std::size_t> slots(numItems, 0u);
+			std::atomic<std::size_t> numCalls{ 0u };
+			om::par::forEachIndex
+				( numItems
+				, numThreads
+				, [&slots, &numCalls]
+					( std::size_t const ndx
+					)
+					{
+						slots[ndx] = ndx + 1u;
+						++numCalls;
+					}
+				);
+
+			bool okay{ (numItems == numCalls) };
+			for (std::size_t ndx{0u} ; okay && (ndx < numItems) ; ++ndx)
+			{
+				okay = ((ndx + 1u) == slots[ndx]);
+			}
+			if (! okay)
+			{
+				oss << "Failure of forEachIndex coverage test\n";
+				oss << "numThreads: " << numThreads << '\n';
+				oss << "  numCalls: " << numCalls << '\n';
+				break;
+			}
+		}
+
+		// empty range should not call function
+		std::size_t numEmptyCalls{ 0u };
+		om::par::forEachIndex
+			(0u, 4u, [&numEmptyCalls] (std::size_t) { ++numEmptyCalls; });
+		if (! (0u == numEmptyCalls))
+		{
+			oss << "Failure of forEachIndex empty range test\n";
+			oss << "numEmptyCalls: " << numEmptyCalls << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of Parallel utilities
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testBlocks(oss);
+	testPool(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,221 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania::prof
+*/
+
+
+#include "Profile.hpp"
+
+#include "OriMania.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// [DoxyExample01]
+
+		// start accumulation from zero
+		prof::reset();
+
+		{
+			// time (and count) a stage with a nested stage
+			prof::StageTimer const outer(prof::Stage::Fit);
+			{
+				prof::StageTimer const inner(prof::Stage::Select);
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+			prof::count(prof::Counter::Conventions, 5u);
+		}
+
+		// calls to Convention::transformFor are counted by the library
+		ParmGroup const pg{ { 1., 2., 3. }, { .1, .2, .3 } };
+		Convention const convention{ Convention::allConventions()[17] };
+		(void)convention.transformFor(pg);
+
+		// current values (all zero if built without instrumentation)
+		prof::Snapshot const snap{ prof::Snapshot::current() };
+		double const selectSeconds{ snap.secondsFor(prof::Stage::Select) };
+		std::uint64_t const numXfms
+			{ snap.countFor(prof::Counter::TransformFor) };
+
+		// [DoxyExample01]
+
+		if (prof::sIsEnabled)
+		{
+			// inner stage time is not included in the outer stage
+			double const fitSeconds{ snap.secondsFor(prof::Stage::Fit) };
+			if (! (.020 <= selectSeconds))
+			{
+				oss << "Failure of nested stage time test\n";
+				oss << "selectSeconds: " << selectSeconds << '\n';
+			}
+			if (! (fitSeconds < selectSeconds))
+			{
+				oss << "Failure of exclusive stage time test\n";
+				oss << "fitSeconds: " << fitSeconds << '\n';
+				oss << "selectSeconds: " << selectSeconds << '\n';
+			}
+
+			constexpr std::size_t ndxFit
+				{ static_cast<std::size_t>(prof::Stage::Fit) };
+			constexpr std::size_t ndxLoad
+				{ static_cast<std::size_t>(prof::Stage::Load) };
+			if (! ((1u == snap.theStageCalls[ndxFit])
+				&& (0u == snap.theStageCalls[ndxLoad])))
+			{
+				oss << "Failure of stage call count test\n";
+			}
+
+			if (! (1u == numXfms))
+			{
+				oss << "Failure of transformFor count test\n";
+				oss << "exp: " << 1u << '\n';
+				oss << "got: " << numXfms << '\n';
+			}
+			if (! (5u == snap.countFor(prof::Counter::Conventions)))
+			{
+				oss << "Failure of conventions count test\n";
+			}
+			if (! (selectSeconds <= snap.theWallSeconds))
+			{
+				oss << "Failure of wall time test\n";
+			}
+
+			// counts from other threads are included once they end
+			std::thread worker
+				{ [] ()
+					{
+						prof::count(prof::Counter::Conventions, 7u);
+					}
+				};
+			worker.join();
+			prof::Snapshot const snapAll{ prof::Snapshot::current() };
+			std::uint64_t const gotNumCons
+				{ snapAll.countFor(prof::Counter::Conventions) };
+			if (! (12u == gotNumCons))
+			{
+				oss << "Failure of worker thread count test\n";
+				oss << "exp: " << 12u << '\n';
+				oss << "got: " << gotNumCons << '\n';
+			}
+
+			// reset restores zero values
+			prof::reset();
+			prof::Snapshot const zero{ prof::Snapshot::current() };
+			if (! ((0. == zero.secondsFor(prof::Stage::Select))
+				&& (0u == zero.countFor(prof::Counter::TransformFor))))
+			{
+				oss << "Failure of reset test\n";
+			}
+		}
+		else
+		{
+			if (! ((0. == selectSeconds) && (0u == numXfms)))
+			{
+				oss << "Failure of disabled instrumentation test\n";
+			}
+		}
+	}
+
+	//! Check report formats
+	void
+	testReport
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		prof::Snapshot snap{};
+		snap.theStageSeconds[static_cast<std::size_t>(prof::Stage::Fit)] = 2.;
+		snap.theCounts[static_cast<std::size_t>(prof::Counter::Conventions)]
+			= 1000u;
+		snap.theWallSeconds = 4.;
+
+		double const expRate{ 250. };
+		double const gotRate{ snap.conventionsPerSecond() };
+		if (! (expRate == gotRate))
+		{
+			oss << "Failure of conventionsPerSecond test\n";
+			oss << "exp: " << expRate << '\n';
+			oss << "got: " << gotRate << '\n';
+		}
+
+		std::string const json{ snap.json() };
+		std::string const info{ snap.infoString() };
+		if (! (  (std::string::npos != json.find("\"stage\": \"fit\""))
+			  && (std::string::npos != json.find("\"conventions\": 1000"))
+			  && (std::string::npos != json.find("\"enabled\""))
+			  ))
+		{
+			oss << "Failure of json content test\n";
+			oss << json << '\n';
+		}
+		if (! (0u == info.find("# Profile:")))
+		{
+			oss << "Failure of infoString content test\n";
+			oss << info << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of NS
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testReport(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,257 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for OriMania::sim
+*/
+
+
+#include "Simulation.hpp"
+
+#include "OriMania.hpp"
+
+#include <iostream>
+#include <sstream>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		// [DoxyExample01]
+
+		// synthetic payload (with random ground truth conventions)
+		sim::PayloadSpec spec;
+		spec.theNumSensors = 10u;
+		spec.theSeed = 12345u;
+		sim::Payload const payload{ sim::Payload::from(spec) };
+
+		// text readable by loaders (e.g. save to files for OriAnalysis)
+		std::string const boxText
+			{ sim::parmGroupText(payload.theBoxKeyPGs) };
+		std::string const indText
+			{ sim::parmGroupText(payload.theIndKeyPGs) };
+		std::string const eoText
+			{ sim::indEOText(payload.theIndKeyPGs, payload.theIndConvention) };
+
+		// [DoxyExample01]
+
+		// same seed, same payload
+		sim::Payload const again{ sim::Payload::from(spec) };
+		if (! ( (boxText == sim::parmGroupText(again.theBoxKeyPGs))
+			 && (indText == sim::parmGroupText(again.theIndKeyPGs))
+			  ) )
+		{
+			oss << "Failure of seeded reproducibility test\n";
+		}
+
+		// different seed, different payload
+		sim::PayloadSpec specB{ spec };
+		specB.theSeed = spec.theSeed + 1u;
+		sim::Payload const other{ sim::Payload::from(specB) };
+		if (boxText == sim::parmGroupText(other.theBoxKeyPGs))
+		{
+			oss << "Failure of different seed test\n";
+		}
+
+		// text is loaded as simulated
+		std::map<SenKey, ParmGroup> const gotBoxPGs{ loadParmGroups(boxText) };
+		std::map<SenKey, SenOri> const gotIndOris{ loadIndEOs(eoText) };
+		bool okayBox{ gotBoxPGs.size() == spec.theNumSensors };
+		for (std::map<SenKey, ParmGroup>::value_type
+			const & expKeyPG : payload.theBoxKeyPGs)
+		{
+			std::map<SenKey, ParmGroup>::const_iterator const itGot
+				{ gotBoxPGs.find(expKeyPG.first) };
+			okayBox = okayBox
+				&& (gotBoxPGs.end() != itGot)
+				&& (expKeyPG.second.theDistances == itGot->second.theDistances)
+				&& (expKeyPG.second.theAngles == itGot->second.theAngles);
+		}
+		if (! okayBox)
+		{
+			oss << "Failure of Box ParmGroup text test\n";
+		}
+		bool okayInd{ gotIndOris.size() == spec.theNumSensors };
+		for (std::map<SenKey, SenOri>::value_type
+			const & expKeyOri : payload.theIndKeyOris)
+		{
+			std::map<SenKey, SenOri>::const_iterator const itGot
+				{ gotIndOris.find(expKeyOri.first) };
+			okayInd = okayInd
+				&& (gotIndOris.end() != itGot)
+				&& (rmseBasisErrorBetween(expKeyOri.second, itGot->second)
+					< 1.e-9);
+		}
+		if (! okayInd)
+		{
+			oss << "Failure of Ind EO text test\n";
+		}
+	}
+
+	//! Check parameter values recovered from orientations
+	void
+	testParmGroupFor
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		rigibra::Transform const ori
+			{ rigibra::Location{ 12.5, -7.25, 3.125 }
+			, rigibra::Attitude(rigibra::PhysAngle{ .7, -1.1, 2.3 })
+			};
+
+		// all (Ind) conventions and a sample of others
+		std::vector<Convention> const allCons{ Convention::allConventions() };
+		std::size_t numBad{ 0u };
+		double maxErr{ 0. };
+		for (std::size_t cNdx{0u} ; cNdx < allCons.size() ; cNdx += 37u)
+		{
+			Convention const & convention = allCons[cNdx];
+			ParmGroup const pg{ sim::parmGroupFor(ori, convention) };
+			double const err
+				{ rmseBasisErrorBetween(convention.transformFor(pg), ori) };
+			maxErr = std::max(maxErr, err);
+			if (! (err < 1.e-9))
+			{
+				++numBad;
+			}
+		}
+		if (! (0u == numBad))
+		{
+			oss << "Failure of parmGroupFor round trip test\n";
+			oss << "numBad: " << numBad << '\n';
+			oss << "maxErr: " << maxErr << '\n';
+		}
+	}
+
+	//! Check that solution recovers the simulated conventions
+	void
+	testSolution
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		sim::PayloadSpec spec;
+		spec.theNumSensors = 12u;
+		spec.theSeed = 7u;
+		sim::Payload const payload{ sim::Payload::from(spec) };
+
+		SenRegistry const registry
+			{ SenRegistry::fromKeysOf
+				(payload.theBoxKeyPGs, payload.theIndKeyPGs)
+			};
+		BoxRelOriTable const boxTable
+			{ BoxRelOriTable::from
+				( registry
+				, attitudeTablesFor(registry, payload.theBoxKeyPGs)
+				, Convention::allConventions()
+				)
+			};
+		std::vector<AttitudeTable> const indTables
+			{ attitudeTablesFor(registry, payload.theIndKeyPGs) };
+		FitNdxSelector const selector
+			{ fitSelectionFor
+				(boxTable, indTables, payload.theIndConvention, 1u)
+			};
+
+		// best fit is (indistinguishable from) the ground truth
+		std::vector<std::size_t> const & classNdxs
+			= boxTable.theClasses.theClassNdxs;
+		std::size_t const expNdx
+			{ static_cast<std::size_t>
+				(conventionIdFor(payload.theBoxConvention))
+			};
+		FitNdxPair const & gotBest = selector.bests().front();
+		if (! ( (gotBest.first < 1.e-9)
+			 && (classNdxs[expNdx] == classNdxs[gotBest.second])
+			  ) )
+		{
+			oss << "Failure of simulated convention solution test\n";
+			oss << "exp: " << ConventionText::from(payload.theBoxConvention)
+				.view() << '\n';
+			oss << "got: " << ConventionText::from
+				(static_cast<ConventionId>(gotBest.second)).view() << '\n';
+			oss << "gotErr: " << gotBest.first << '\n';
+		}
+
+		// noise increases fit error (but best fit remains the same)
+		sim::PayloadSpec specNoise{ spec };
+		specNoise.theDistanceSigma = .001;
+		specNoise.theAngleSigma = .000001;
+		sim::Payload const noisy{ sim::Payload::from(specNoise) };
+		FitNdxSelector const noisySelector
+			{ fitSelectionFor
+				( boxTable
+				, attitudeTablesFor(registry, noisy.theIndKeyPGs)
+				, noisy.theIndConvention, 1u
+				)
+			};
+		FitNdxPair const & noisyBest = noisySelector.bests().front();
+		if (! ( (1.e-9 < noisyBest.first)
+			 && (noisyBest.first < .1)
+			 && (classNdxs[expNdx] == classNdxs[noisyBest.second])
+			  ) )
+		{
+			oss << "Failure of noisy simulated solution test\n";
+			oss << "noisyErr: " << noisyBest.first << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of NS
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testParmGroupFor(oss);
+	testSolution(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -30,6 +30,7 @@
 
 #include "io.hpp"
 
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -232,6 +233,90 @@ namespace
 
 	} // testParmGroup
 
+	//! Check (legacy stream extraction) format details and file loading
+	void
+	testFormat
+		( std::ostream & oss
+		)
+	{
+		using namespace om;
+
+		std::string const text
+			{ "Distances: sen1 +1 2. -.5e1 # comment\r\n"
+			  "Angles:\tsen1 .1 -2e-1\t.3\r\n"
+			  "Distances: sen2 1 2 x # (non-number is read as zero)\n"
+			  "Angles: sen2 4 5 6\n"
+			  "Distances: sen3 1 2 # (missing value)\n"
+			  "Angles: sen3 1 2 3\n"
+			  "Distances: sen4 1 2 3\n"
+			  "Angles: sen4 1 2 1.e # (incomplete exponent is zero)\n"
+			  "Distances: sen5 1 2 inf # (not a number for operator>>)\n"
+			  "Angles: sen5 1 2 3\n"
+			  "Distances: sen6 7 8 9 # (replaced by later record below)\n"
+			  "Angles: sen6 4 5 6\n"
+			  "Distances: sen6 1 2 3\n"
+			  "Distances: sen7 1 2 3\n"
+			  "Angles: sen7 1.5x2 3 # (no more values after zero)"
+			};
+
+		std::map<SenKey, ParmGroup> const expPGs
+			{ { "sen1", ParmGroup{ { 1., 2., -5. }, { .1, -.2, .3 } } }
+			, { "sen2", ParmGroup{ { 1., 2., 0. }, { 4., 5., 6. } } }
+			, { "sen4", ParmGroup{ { 1., 2., 3. }, { 1., 2., 0. } } }
+			, { "sen5", ParmGroup{ { 1., 2., 0. }, { 1., 2., 3. } } }
+			, { "sen6", ParmGroup{ { 1., 2., 3. }, { 4., 5., 6. } } }
+			};
+
+		// text (view) and stream loaders
+		std::map<SenKey, ParmGroup> const gotPGs{ loadParmGroups(text) };
+		std::istringstream iss(text);
+		std::map<SenKey, ParmGroup> const gotStrmPGs{ loadParmGroups(iss) };
+
+		// (memory mapped) file loader
+		std::filesystem::path const path
+			{ std::filesystem::temp_directory_path() / "test_io_Format.txt" };
+		{
+			std::ofstream ofs(path, std::ios::binary);
+			ofs << text;
+		}
+		std::map<SenKey, ParmGroup> const gotFilePGs
+			{ loadParmGroupsFile(path) };
+		std::filesystem::remove(path);
+
+		using PGsItem = std::pair<std::string, std::map<SenKey, ParmGroup> >;
+		for (PGsItem const & gotItem
+			: { PGsItem{ "text", gotPGs }
+			  , PGsItem{ "stream", gotStrmPGs }
+			  , PGsItem{ "file", gotFilePGs }
+			  })
+		{
+			bool same{ (gotItem.second.size() == expPGs.size()) };
+			std::map<SenKey, ParmGroup>::const_iterator
+				itGot{ gotItem.second.cbegin() };
+			for (std::map<SenKey, ParmGroup>::value_type
+				const & expPG : expPGs)
+			{
+				same =  same
+					&& (itGot->first == expPG.first)
+					&& (itGot->second.theDistances == expPG.second.theDistances)
+					&& (itGot->second.theAngles == expPG.second.theAngles);
+				if (same)
+				{
+					++itGot;
+				}
+			}
+			if (! same)
+			{
+				oss << "Failure of loadParmGroups format test\n";
+				oss << "loader: " << gotItem.first << '\n';
+				for (std::map<SenKey, ParmGroup>::value_type
+					const & gotPG : gotItem.second)
+				{
+					oss << gotPG.first << ' ' << gotPG.second << '\n';
+				}
+			}
+		}
+	}
 }
 
 //! Check behavior of NS
@@ -244,6 +329,7 @@ main
 
 	testIndEO(oss);
 	testParmGroup(oss);
+	testFormat(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
 	{